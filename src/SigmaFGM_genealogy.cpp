@@ -0,0 +1,268 @@
+
+/**
+ * \file      SigmaFGM_genealogy.cpp
+ * \authors   Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * \date      18-10-2026
+ * \copyright Copyright (C) 2016-2020 Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard. All rights reserved
+ * \license   This project is released under the GNU General Public License
+ * \brief     Read the genealogy tables
+ */
+
+/***********************************************************************
+ * Copyright (C) 2016-2020
+ * Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * Web: https://github.com/charlesrocabert/SigmaFGM/
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#include "../cmake/Config.h"
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstring>
+#include <unordered_map>
+#include <assert.h>
+
+#include "./lib/Macros.h"
+#include "./lib/Enums.h"
+#include "./lib/Structs.h"
+#include "./lib/GenealogyReader.h"
+
+void readArgs( int argc, char const** argv, std::string& nodes_filename, std::string& edges_filename, bool& text );
+void printUsage( void );
+void writeNodeHeader( std::ofstream& file );
+void writeNode( std::ofstream& file, const genealogy_node& node );
+
+
+/**
+ * \brief    Main function
+ * \details  Reads the genealogy tables streamed by SigmaFGM_simulation
+ *           (-genealogy option), checks their consistency and prints a
+ *           summary. With -text, the tables are also converted to text files
+ * \param    int argc
+ * \param    char const** argv
+ * \return   \e int
+ */
+int main( int argc, char const** argv )
+{
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 1) Read parameters                 */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  std::string nodes_filename = "genealogy_nodes.bin";
+  std::string edges_filename = "genealogy_edges.bin";
+  bool        text           = false;
+  readArgs(argc, argv, nodes_filename, edges_filename, text);
+  GenealogyReader* reader = new GenealogyReader(nodes_filename, edges_filename);
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 2) Read the node table             */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  std::ofstream nodes_file;
+  if (text)
+  {
+    nodes_file.open("genealogy_nodes.txt", std::ios::out | std::ios::trunc);
+    writeNodeHeader(nodes_file);
+  }
+  std::unordered_map<unsigned long long int, int> generations;
+  genealogy_node         node;
+  unsigned long long int number_of_samples = 0;
+  int                    first_generation  = 0;
+  int                    last_generation   = 0;
+  while (reader->read_node(node))
+  {
+    if (!generations.insert(std::make_pair(node.identifier, node.generation)).second)
+    {
+      std::cout << "Error: node " << node.identifier << " is written twice.\n";
+      exit(EXIT_FAILURE);
+    }
+    if (generations.size() == 1 || first_generation > node.generation)
+    {
+      first_generation = node.generation;
+    }
+    if (generations.size() == 1 || last_generation < node.generation)
+    {
+      last_generation = node.generation;
+    }
+    if (node.flags & GENEALOGY_SAMPLE)
+    {
+      number_of_samples++;
+    }
+    if (text)
+    {
+      writeNode(nodes_file, node);
+    }
+  }
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 3) Read the edge table             */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  std::ofstream edges_file;
+  if (text)
+  {
+    edges_file.open("genealogy_edges.txt", std::ios::out | std::ios::trunc);
+    edges_file << "parent" << " " << "child" << "\n";
+  }
+  std::unordered_map<unsigned long long int, unsigned long long int> parents;
+  genealogy_edge         edge;
+  unsigned long long int number_of_edges = 0;
+  while (reader->read_edge(edge))
+  {
+    if (generations.find(edge.parent) == generations.end() || generations.find(edge.child) == generations.end())
+    {
+      std::cout << "Error: edge " << edge.parent << " -> " << edge.child << " refers to an unknown node.\n";
+      exit(EXIT_FAILURE);
+    }
+    if (!parents.insert(std::make_pair(edge.child, edge.parent)).second)
+    {
+      std::cout << "Error: node " << edge.child << " has several parents.\n";
+      exit(EXIT_FAILURE);
+    }
+    number_of_edges++;
+    if (text)
+    {
+      edges_file << edge.parent << " " << edge.child << "\n";
+    }
+  }
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 4) Print the summary               */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  std::cout << "nodes       " << generations.size() << "\n";
+  std::cout << "samples     " << number_of_samples << "\n";
+  std::cout << "edges       " << number_of_edges << "\n";
+  std::cout << "roots       " << generations.size()-parents.size() << "\n";
+  std::cout << "generations " << first_generation << " to " << last_generation << "\n";
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 5) Free memory                     */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  if (text)
+  {
+    nodes_file.close();
+    edges_file.close();
+  }
+  delete reader;
+  reader = NULL;
+  return EXIT_SUCCESS;
+}
+
+/**
+ * \brief    Read arguments
+ * \details  --
+ * \param    int argc
+ * \param    char const** argv
+ * \param    std::string& nodes_filename
+ * \param    std::string& edges_filename
+ * \param    bool& text
+ * \return   \e void
+ */
+void readArgs( int argc, char const** argv, std::string& nodes_filename, std::string& edges_filename, bool& text )
+{
+  for (int i = 0; i < argc; i++)
+  {
+    if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0)
+    {
+      printUsage();
+      exit(EXIT_SUCCESS);
+    }
+    else if (strcmp(argv[i], "-text") == 0 || strcmp(argv[i], "--text") == 0)
+    {
+      text = true;
+    }
+    else if (i+1 == argc)
+    {
+      continue;
+    }
+    else if (strcmp(argv[i], "-nodes") == 0 || strcmp(argv[i], "--nodes") == 0)
+    {
+      nodes_filename = argv[i+1];
+    }
+    else if (strcmp(argv[i], "-edges") == 0 || strcmp(argv[i], "--edges") == 0)
+    {
+      edges_filename = argv[i+1];
+    }
+  }
+}
+
+/**
+ * \brief    Print usage
+ * \details  --
+ * \param    void
+ * \return   \e void
+ */
+void printUsage( void )
+{
+  std::cout << "\n";
+  std::cout << "Usage: SigmaFGM_genealogy -h or --help\n";
+  std::cout << "   or: SigmaFGM_genealogy [options]\n";
+  std::cout << "Options are:\n";
+  std::cout << "  -h, --help\n";
+  std::cout << "        print this help, then exit\n";
+  std::cout << "  -nodes, --nodes\n";
+  std::cout << "        specify the node table (default genealogy_nodes.bin)\n";
+  std::cout << "  -edges, --edges\n";
+  std::cout << "        specify the edge table (default genealogy_edges.bin)\n";
+  std::cout << "  -text, --text\n";
+  std::cout << "        Indicates if the tables should be converted to genealogy_nodes.txt and genealogy_edges.txt\n";
+  std::cout << "\n";
+}
+
+/**
+ * \brief    Write the header of the text node table
+ * \details  Same columns as best_lineage.txt, and the sample flag
+ * \param    std::ofstream& file
+ * \return   \e void
+ */
+void writeNodeHeader( std::ofstream& file )
+{
+  file << "id" << " ";
+  file << "t" << " ";
+  file << "sample" << " ";
+  file << "dmu" << " ";
+  file << "dz" << " ";
+  file << "Wmu" << " ";
+  file << "Wz" << " ";
+  file << "EV" << " ";
+  file << "EV_contrib" << " ";
+  file << "EV_dot_product" << " ";
+  file << "r_mu" << " ";
+  file << "r_sigma" << " ";
+  file << "r_theta" << "\n";
+}
+
+/**
+ * \brief    Write a node in the text node table
+ * \details  --
+ * \param    std::ofstream& file
+ * \param    const genealogy_node& node
+ * \return   \e void
+ */
+void writeNode( std::ofstream& file, const genealogy_node& node )
+{
+  file << node.identifier << " ";
+  file << node.generation << " ";
+  file << (node.flags & GENEALOGY_SAMPLE ? 1 : 0) << " ";
+  file << node.dmu << " ";
+  file << node.dz << " ";
+  file << node.Wmu << " ";
+  file << node.Wz << " ";
+  file << node.EV << " ";
+  file << node.EV_contrib << " ";
+  file << node.EV_dot_product << " ";
+  file << node.r_mu << " ";
+  file << node.r_sigma << " ";
+  file << node.r_theta << "\n";
+}
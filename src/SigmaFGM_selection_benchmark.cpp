@@ -0,0 +1,260 @@
+/**
+ * \file      SigmaFGM_selection_benchmark.cpp
+ * \authors   Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * \date      18-10-2026
+ * \copyright Copyright (C) 2016-2020 Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard. All rights reserved
+ * \license   This project is released under the GNU General Public License
+ * \brief     Benchmark the selection samplers
+ */
+
+/***********************************************************************
+ * Copyright (C) 2016-2020
+ * Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * Web: https://github.com/charlesrocabert/SigmaFGM/
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#include "../cmake/Config.h"
+
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+#include <chrono>
+#include <cmath>
+#include <assert.h>
+
+#include "./lib/Macros.h"
+#include "./lib/Enums.h"
+#include "./lib/Prng.h"
+#include "./lib/ThreadPool.h"
+#include "./lib/Selection.h"
+
+void   readArgs( int argc, char const** argv, int& N, int& iterations, int& threads, unsigned long int& seed );
+void   printUsage( void );
+double benchmark( selection_sampler sampler, const char* name, int N, int iterations, ThreadPool* thread_pool, unsigned long int seed, const double* w, double w_sum, double reference_time );
+
+
+/**
+ * \brief    Main function
+ * \details  Draws N offspring among N parents with each sampler, on a fitness
+ *           vector shaped like the simulation one, and compares the running
+ *           times to the gsl_ran_multinomial path
+ * \param    int argc
+ * \param    char const** argv
+ * \return   \e int
+ */
+int main( int argc, char const** argv )
+{
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 1) Read parameters                 */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  int               N          = 10000;
+  int               iterations = 1000;
+  int               threads    = 0;
+  unsigned long int seed       = 1;
+  readArgs(argc, argv, N, iterations, threads, seed);
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 2) Draw a fitness vector           */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  Prng* prng = new Prng();
+  prng->set_seed(seed);
+  double* w     = new double[N];
+  double  w_sum = 0.0;
+  for (int i = 0; i < N; i++)
+  {
+    double d  = fabs(prng->gaussian(0.0, 1.0));
+    w[i]      = exp(-0.5*d*d);
+    w_sum    += w[i];
+  }
+  delete prng;
+  prng = NULL;
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 3) Run the benchmarks              */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  ThreadPool* thread_pool = (threads > 0 ? new ThreadPool(threads, false) : NULL);
+  std::cout << "N = " << N << ", " << iterations << " draws, " << threads << " threads\n";
+  std::cout << "sampler      time/draw (us)  speedup  max |mean-expected|/sd\n";
+  double reference_time = benchmark(GSL_MULTINOMIAL, "GSL", N, iterations, thread_pool, seed, w, w_sum, 0.0);
+  benchmark(CONDITIONAL_BINOMIAL, "BINOMIAL", N, iterations, thread_pool, seed, w, w_sum, reference_time);
+  benchmark(SORTED_UNIFORMS, "SORTED", N, iterations, thread_pool, seed, w, w_sum, reference_time);
+  benchmark(BINOMIAL_SPLITTING, "SPLITTING", N, iterations, thread_pool, seed, w, w_sum, reference_time);
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 4) Free memory                     */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  delete[] w;
+  w = NULL;
+  if (thread_pool != NULL)
+  {
+    delete thread_pool;
+    thread_pool = NULL;
+  }
+  return EXIT_SUCCESS;
+}
+
+/**
+ * \brief    Read arguments
+ * \details  --
+ * \param    int argc
+ * \param    char const** argv
+ * \param    int& N
+ * \param    int& iterations
+ * \param    int& threads
+ * \param    unsigned long int& seed
+ * \return   \e void
+ */
+void readArgs( int argc, char const** argv, int& N, int& iterations, int& threads, unsigned long int& seed )
+{
+  for (int i = 0; i < argc; i++)
+  {
+    if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0)
+    {
+      printUsage();
+      exit(EXIT_SUCCESS);
+    }
+    else if (i+1 == argc)
+    {
+      continue;
+    }
+    else if (strcmp(argv[i], "-popsize") == 0 || strcmp(argv[i], "--population-size") == 0)
+    {
+      N = atoi(argv[i+1]);
+    }
+    else if (strcmp(argv[i], "-iterations") == 0 || strcmp(argv[i], "--iterations") == 0)
+    {
+      iterations = atoi(argv[i+1]);
+    }
+    else if (strcmp(argv[i], "-threads") == 0 || strcmp(argv[i], "--threads") == 0)
+    {
+      threads = atoi(argv[i+1]);
+    }
+    else if (strcmp(argv[i], "-seed") == 0 || strcmp(argv[i], "--seed") == 0)
+    {
+      seed = (unsigned long int)atol(argv[i+1]);
+    }
+  }
+  if (N <= 0 || iterations <= 0 || threads < 0)
+  {
+    std::cout << "Error: wrong parameter value (see -h or --help).\n";
+    exit(EXIT_FAILURE);
+  }
+}
+
+/**
+ * \brief    Print usage
+ * \details  --
+ * \param    void
+ * \return   \e void
+ */
+void printUsage( void )
+{
+  std::cout << "\n";
+  std::cout << "Usage: SigmaFGM_selection_benchmark -h or --help\n";
+  std::cout << "   or: SigmaFGM_selection_benchmark [options]\n";
+  std::cout << "Options are:\n";
+  std::cout << "  -h, --help\n";
+  std::cout << "        print this help, then exit\n";
+  std::cout << "  -popsize, --population-size\n";
+  std::cout << "        specify the population size (default 10000)\n";
+  std::cout << "  -iterations, --iterations\n";
+  std::cout << "        specify the number of draws per sampler (default 1000)\n";
+  std::cout << "  -threads, --threads\n";
+  std::cout << "        specify the number of threads used by the SPLITTING sampler (default 0)\n";
+  std::cout << "  -seed, --seed\n";
+  std::cout << "        specify the prng seed (default 1)\n";
+  std::cout << "\n";
+}
+
+/**
+ * \brief    Benchmark a sampler
+ * \details  Also checks the sampler: each draw must hand out exactly N
+ *           offspring, and the mean number of offspring of each parent must
+ *           match its expectation N*w/w_sum (the largest deviation is given in
+ *           standard errors)
+ * \param    selection_sampler sampler
+ * \param    const char* name
+ * \param    int N
+ * \param    int iterations
+ * \param    ThreadPool* thread_pool
+ * \param    unsigned long int seed
+ * \param    const double* w
+ * \param    double w_sum
+ * \param    double reference_time
+ * \return   \e double
+ */
+double benchmark( selection_sampler sampler, const char* name, int N, int iterations, ThreadPool* thread_pool, unsigned long int seed, const double* w, double w_sum, double reference_time )
+{
+  Selection*    selection = new Selection(sampler, N, thread_pool);
+  Prng*         prng      = new Prng();
+  unsigned int* draws     = new unsigned int[N];
+  double*       sums      = new double[N];
+  prng->set_seed(seed);
+  for (int i = 0; i < N; i++)
+  {
+    sums[i] = 0.0;
+  }
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 1) Time the draws                  */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  double elapsed = 0.0;
+  for (int it = 0; it < iterations; it++)
+  {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    selection->draw(prng, w, w_sum, draws);
+    elapsed += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now()-start).count();
+    unsigned int total = 0;
+    for (int i = 0; i < N; i++)
+    {
+      total   += draws[i];
+      sums[i] += (double)draws[i];
+    }
+    if (total != (unsigned int)N)
+    {
+      std::cout << "Error: sampler " << name << " handed out " << total << " offspring instead of " << N << ".\n";
+      exit(EXIT_FAILURE);
+    }
+  }
+  elapsed /= (double)iterations;
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 2) Check the mean draws            */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  double max_deviation = 0.0;
+  for (int i = 0; i < N; i++)
+  {
+    double p         = w[i]/w_sum;
+    double expected  = N*p;
+    double sd        = sqrt(N*p*(1.0-p)/(double)iterations);
+    double deviation = fabs(sums[i]/(double)iterations-expected)/sd;
+    if (max_deviation < deviation)
+    {
+      max_deviation = deviation;
+    }
+  }
+  std::cout << std::left << std::setw(13) << name << std::setw(16) << elapsed << std::setw(9) << (reference_time > 0.0 ? reference_time/elapsed : 1.0) << max_deviation << "\n";
+  
+  delete[] draws;
+  draws = NULL;
+  delete[] sums;
+  sums = NULL;
+  delete prng;
+  prng = NULL;
+  delete selection;
+  selection = NULL;
+  return elapsed;
+}
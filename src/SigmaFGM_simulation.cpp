@@ -32,17 +32,22 @@
 #include <iostream>
 #include <sstream>
 #include <cstring>
+#include <vector>
 #include <sys/stat.h>
 #include <assert.h>
 
 #include "./lib/Macros.h"
 #include "./lib/Enums.h"
 #include "./lib/Parameters.h"
+#include "./lib/Kernels.h"
+#include "./lib/Memory.h"
 #include "./lib/Simulation.h"
 
 void readArgs( int argc, char const** argv, Parameters* parameters );
+std::vector<Parameters*> readVariants( int argc, char const** argv, Parameters* parameters );
+void runSimulation( Parameters* parameters );
 void printUsage( void );
-void printHeader( void );
+void printHeader( Parameters* parameters );
 
 
 /**
@@ -63,14 +68,53 @@ int main( int argc, char const** argv )
   {
     parameters->set_seed((unsigned long int)time(NULL));
   }
+  Kernels::select();
+  Memory::set_hugepages(parameters->get_hugepages());
+  Prng::set_gaussian_sampler(parameters->get_gaussian_sampler());
+  printHeader(parameters);
   
   /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
-  /* 2) Create the simulation           */
+  /* 2) Read the paired variants        */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  std::vector<Parameters*> variants = readVariants(argc, argv, parameters);
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 3) Run each variant                */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  for (size_t v = 0; v < variants.size(); v++)
+  {
+    runSimulation(variants[v]);
+  }
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 4) Free memory                     */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  for (size_t v = 1; v < variants.size(); v++)
+  {
+    delete variants[v];
+    variants[v] = NULL;
+  }
+  delete parameters;
+  parameters = NULL;
+  
+  return EXIT_SUCCESS;
+}
+
+/**
+ * \brief    Run the simulation of a set of parameters
+ * \details  --
+ * \param    Parameters* parameters
+ * \return   \e void
+ */
+void runSimulation( Parameters* parameters )
+{
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 1) Create the simulation           */
   /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
   Simulation* simulation = new Simulation(parameters);
   
   /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
-  /* 3) Stabilize the population        */
+  /* 2) Stabilize the population        */
   /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
   if (parameters->get_number_of_stabilizing_generations() > 0)
   {
@@ -78,7 +122,7 @@ int main( int argc, char const** argv )
   }
   
   /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
-  /* 4) Run the simulation              */
+  /* 3) Run the simulation              */
   /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
   if (parameters->get_shutoff_distance() == 0)
   {
@@ -86,7 +130,7 @@ int main( int argc, char const** argv )
   }
   
   /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
-  /* 5) Run the simulation with shutoff */
+  /* 4) Run the simulation with shutoff */
   /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
   if (parameters->get_shutoff_distance() > 0.0)
   {
@@ -94,14 +138,10 @@ int main( int argc, char const** argv )
   }
   
   /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
-  /* 6) Free memory                     */
+  /* 5) Free memory                     */
   /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
   delete simulation;
   simulation = NULL;
-  delete parameters;
-  parameters = NULL;
-  
-  return EXIT_SUCCESS;
 }
 
 /**
@@ -150,6 +190,81 @@ void readArgs( int argc, char const** argv, Parameters* parameters )
         counter++;
       }
     }
+    else if (strcmp(argv[i], "-replicates") == 0 || strcmp(argv[i], "--replicates") == 0)
+    {
+      if (i+1 == argc)
+      {
+        std::cout << "Error: command line parameter value is missing.\n";
+        exit(EXIT_FAILURE);
+      }
+      else
+      {
+        parameters->set_number_of_replicates(atoi(argv[i+1]));
+      }
+    }
+    else if (strcmp(argv[i], "-pair") == 0 || strcmp(argv[i], "--pair") == 0)
+    {
+      if (i+2 >= argc)
+      {
+        std::cout << "Error: command line parameter value is missing.\n";
+        exit(EXIT_FAILURE);
+      }
+      else
+      {
+        parameters->set_common_random_numbers(true);
+        i += 2;
+      }
+    }
+    else if (strcmp(argv[i], "-prng") == 0 || strcmp(argv[i], "--prng") == 0)
+    {
+      if (i+1 == argc)
+      {
+        std::cout << "Error: command line parameter value is missing.\n";
+        exit(EXIT_FAILURE);
+      }
+      else
+      {
+        prng_type types[4] = {MT19937, PHILOX, XOSHIRO256PP, PCG64};
+        bool      found    = false;
+        for (int t = 0; t < 4 && !found; t++)
+        {
+          if (strcmp(argv[i+1], Prng::get_type_name(types[t])) == 0)
+          {
+            parameters->set_prng_type(types[t]);
+            found = true;
+          }
+        }
+        if (!found)
+        {
+          std::cout << "Error: wrong value for parameter -prng (--prng).\n";
+          exit(EXIT_FAILURE);
+        }
+      }
+    }
+    else if (strcmp(argv[i], "-gaussian") == 0 || strcmp(argv[i], "--gaussian") == 0)
+    {
+      if (i+1 == argc)
+      {
+        std::cout << "Error: command line parameter value is missing.\n";
+        exit(EXIT_FAILURE);
+      }
+      else
+      {
+        if (strcmp(argv[i+1], "ZIGGURAT") == 0)
+        {
+          parameters->set_gaussian_sampler(ZIGGURAT);
+        }
+        else if (strcmp(argv[i+1], "BOXMULLER") == 0)
+        {
+          parameters->set_gaussian_sampler(BOX_MULLER);
+        }
+        else
+        {
+          std::cout << "Error: wrong value for parameter -gaussian (--gaussian).\n";
+          exit(EXIT_FAILURE);
+        }
+      }
+    }
     
     /*----------------------------------------------- SIMULATION TIME */
     
@@ -323,6 +438,49 @@ void readArgs( int argc, char const** argv, Parameters* parameters )
     {
       parameters->set_mean_fitness(true);
     }
+    else if (strcmp(argv[i], "-skipmono") == 0 || strcmp(argv[i], "--skip-monomorphic") == 0)
+    {
+      parameters->set_skip_monomorphic(true);
+    }
+    
+    /*----------------------------------------------- DEMES */
+    
+    else if (strcmp(argv[i], "-demes") == 0 || strcmp(argv[i], "--demes") == 0)
+    {
+      if (i+1 == argc)
+      {
+        std::cout << "Error: command line parameter value is missing.\n";
+        exit(EXIT_FAILURE);
+      }
+      else
+      {
+        parameters->set_number_of_demes(atoi(argv[i+1]));
+      }
+    }
+    else if (strcmp(argv[i], "-migrate") == 0 || strcmp(argv[i], "--migration-rate") == 0)
+    {
+      if (i+1 == argc)
+      {
+        std::cout << "Error: command line parameter value is missing.\n";
+        exit(EXIT_FAILURE);
+      }
+      else
+      {
+        parameters->set_migration_rate(atof(argv[i+1]));
+      }
+    }
+    else if (strcmp(argv[i], "-migint") == 0 || strcmp(argv[i], "--migration-interval") == 0)
+    {
+      if (i+1 == argc)
+      {
+        std::cout << "Error: command line parameter value is missing.\n";
+        exit(EXIT_FAILURE);
+      }
+      else
+      {
+        parameters->set_migration_interval(atoi(argv[i+1]));
+      }
+    }
     
     /*----------------------------------------------- MUTATIONS */
     
@@ -441,6 +599,162 @@ void readArgs( int argc, char const** argv, Parameters* parameters )
       }
     }
     
+    /*----------------------------------------------- SELECTION */
+    
+    else if (strcmp(argv[i], "-selection") == 0 || strcmp(argv[i], "--selection") == 0)
+    {
+      if (i+1 == argc)
+      {
+        std::cout << "Error: command line parameter value is missing.\n";
+        exit(EXIT_FAILURE);
+      }
+      else
+      {
+        if (strcmp(argv[i+1], "GSL") == 0)
+        {
+          parameters->set_selection_sampler(GSL_MULTINOMIAL);
+        }
+        else if (strcmp(argv[i+1], "BINOMIAL") == 0)
+        {
+          parameters->set_selection_sampler(CONDITIONAL_BINOMIAL);
+        }
+        else if (strcmp(argv[i+1], "SORTED") == 0)
+        {
+          parameters->set_selection_sampler(SORTED_UNIFORMS);
+        }
+        else if (strcmp(argv[i+1], "SPLITTING") == 0)
+        {
+          parameters->set_selection_sampler(BINOMIAL_SPLITTING);
+        }
+        else
+        {
+          std::cout << "Error: wrong value for parameter -selection (--selection).\n";
+          exit(EXIT_FAILURE);
+        }
+      }
+    }
+    else if (strcmp(argv[i], "-model") == 0 || strcmp(argv[i], "--population-model") == 0)
+    {
+      if (i+1 == argc)
+      {
+        std::cout << "Error: command line parameter value is missing.\n";
+        exit(EXIT_FAILURE);
+      }
+      else
+      {
+        if (strcmp(argv[i+1], "WF") == 0)
+        {
+          parameters->set_population_model(WRIGHT_FISHER);
+        }
+        else if (strcmp(argv[i+1], "MORAN") == 0)
+        {
+          parameters->set_population_model(MORAN);
+        }
+        else
+        {
+          std::cout << "Error: wrong value for parameter -model (--population-model).\n";
+          exit(EXIT_FAILURE);
+        }
+      }
+    }
+    
+    /*----------------------------------------------- LINEAGES */
+    
+    else if (strcmp(argv[i], "-lineage") == 0 || strcmp(argv[i], "--lineage-tracking") == 0)
+    {
+      parameters->set_lineage_tracking(true);
+    }
+    else if (strcmp(argv[i], "-lineagelog") == 0 || strcmp(argv[i], "--lineage-log") == 0)
+    {
+      parameters->set_lineage_log(true);
+    }
+    else if (strcmp(argv[i], "-collapse") == 0 || strcmp(argv[i], "--collapse-unary") == 0)
+    {
+      parameters->set_collapse_unary(true);
+    }
+    else if (strcmp(argv[i], "-genealogy") == 0 || strcmp(argv[i], "--genealogy-interval") == 0)
+    {
+      if (i+1 == argc)
+      {
+        std::cout << "Error: command line parameter value is missing.\n";
+        exit(EXIT_FAILURE);
+      }
+      else
+      {
+        parameters->set_genealogy_interval(atoi(argv[i+1]));
+        if (parameters->get_genealogy_interval() <= 0)
+        {
+          std::cout << "Error: wrong value for parameter -genealogy (--genealogy-interval).\n";
+          exit(EXIT_FAILURE);
+        }
+      }
+    }
+    else if (strcmp(argv[i], "-fixstop") == 0 || strcmp(argv[i], "--fixation-stop") == 0)
+    {
+      if (i+1 == argc)
+      {
+        std::cout << "Error: command line parameter value is missing.\n";
+        exit(EXIT_FAILURE);
+      }
+      else
+      {
+        parameters->set_fixation_stop(atoi(argv[i+1]));
+        if (parameters->get_fixation_stop() <= 0)
+        {
+          std::cout << "Error: wrong value for parameter -fixstop (--fixation-stop).\n";
+          exit(EXIT_FAILURE);
+        }
+      }
+    }
+    else if (strcmp(argv[i], "-focal") == 0 || strcmp(argv[i], "--focal-sample-size") == 0)
+    {
+      if (i+1 == argc)
+      {
+        std::cout << "Error: command line parameter value is missing.\n";
+        exit(EXIT_FAILURE);
+      }
+      else
+      {
+        parameters->set_focal_sample_size(atoi(argv[i+1]));
+        if (parameters->get_focal_sample_size() <= 0)
+        {
+          std::cout << "Error: wrong value for parameter -focal (--focal-sample-size).\n";
+          exit(EXIT_FAILURE);
+        }
+      }
+    }
+    else if (strcmp(argv[i], "-mutlog") == 0 || strcmp(argv[i], "--mutation-log") == 0)
+    {
+      parameters->set_mutation_log(true);
+    }
+    
+    /*----------------------------------------------- PARALLELISM */
+    
+    else if (strcmp(argv[i], "-threads") == 0 || strcmp(argv[i], "--threads") == 0)
+    {
+      if (i+1 == argc)
+      {
+        std::cout << "Error: command line parameter value is missing.\n";
+        exit(EXIT_FAILURE);
+      }
+      else
+      {
+        parameters->set_number_of_threads(atoi(argv[i+1]));
+      }
+    }
+    else if (strcmp(argv[i], "-pin") == 0 || strcmp(argv[i], "--pin-threads") == 0)
+    {
+      parameters->set_pin_threads(true);
+    }
+    else if (strcmp(argv[i], "-hugepages") == 0 || strcmp(argv[i], "--hugepages") == 0)
+    {
+      parameters->set_hugepages(true);
+    }
+    else if (strcmp(argv[i], "-asyncout") == 0 || strcmp(argv[i], "--async-output") == 0)
+    {
+      parameters->set_async_output(true);
+    }
+    
     /****************************************************************/
   }
   if (counter < 17)
@@ -448,6 +762,140 @@ void readArgs( int argc, char const** argv, Parameters* parameters )
     printf("You must provide all the mandatory arguments (see -h or --help). Exit.\n");
     exit(EXIT_SUCCESS);
   }
+  if (parameters->get_number_of_replicates() > 1 && parameters->get_number_of_dimensions() > 1)
+  {
+    std::cout << "Error: replicates can only be run in lockstep in one dimension.\n";
+    exit(EXIT_FAILURE);
+  }
+  if (parameters->get_population_model() == MORAN && (parameters->get_number_of_replicates() > 1 || parameters->get_number_of_threads() > 0))
+  {
+    std::cout << "Error: the Moran model runs a single replicate sequentially.\n";
+    exit(EXIT_FAILURE);
+  }
+  if (parameters->get_number_of_demes() > 1 && (parameters->get_number_of_replicates() > 1 || parameters->get_population_model() == MORAN))
+  {
+    std::cout << "Error: demes only run a single replicate with the Wright-Fisher model.\n";
+    exit(EXIT_FAILURE);
+  }
+  if (parameters->get_skip_monomorphic() && (parameters->get_number_of_replicates() > 1 || parameters->get_number_of_demes() > 1 || parameters->get_population_model() == MORAN))
+  {
+    std::cout << "Error: monomorphic phases can only be skipped in a single Wright-Fisher population.\n";
+    exit(EXIT_FAILURE);
+  }
+  if (parameters->get_number_of_demes() > parameters->get_population_size())
+  {
+    std::cout << "Error: there cannot be more demes than individuals.\n";
+    exit(EXIT_FAILURE);
+  }
+  if (parameters->get_common_random_numbers() && (parameters->get_number_of_replicates() > 1 || parameters->get_number_of_demes() > 1 || parameters->get_population_model() == MORAN || parameters->get_skip_monomorphic()))
+  {
+    std::cout << "Error: paired variants only run a single Wright-Fisher population.\n";
+    exit(EXIT_FAILURE);
+  }
+  if ((parameters->get_lineage_tracking() || parameters->get_lineage_log()) && (parameters->get_number_of_replicates() > 1 || parameters->get_number_of_demes() > 1 || parameters->get_common_random_numbers()))
+  {
+    std::cout << "Error: lineages can only be tracked in a single population.\n";
+    exit(EXIT_FAILURE);
+  }
+  if (parameters->get_lineage_tracking() && parameters->get_lineage_log())
+  {
+    std::cout << "Error: lineages are either tracked in a tree or in a log.\n";
+    exit(EXIT_FAILURE);
+  }
+  if ((parameters->get_lineage_tracking() || parameters->get_lineage_log()) && parameters->get_skip_monomorphic())
+  {
+    std::cout << "Error: lineages cannot be tracked while skipping monomorphic phases.\n";
+    exit(EXIT_FAILURE);
+  }
+  if (parameters->get_genealogy_interval() > 0 && !parameters->get_lineage_tracking())
+  {
+    std::cout << "Error: the genealogy can only be exported with lineage tracking.\n";
+    exit(EXIT_FAILURE);
+  }
+  if (parameters->get_fixation_stop() > 0 && !parameters->get_lineage_tracking())
+  {
+    std::cout << "Error: fixations can only be detected with lineage tracking.\n";
+    exit(EXIT_FAILURE);
+  }
+  if (parameters->get_focal_sample_size() > 0 && !parameters->get_lineage_tracking() && !parameters->get_lineage_log())
+  {
+    std::cout << "Error: the focal sample requires lineage tracking.\n";
+    exit(EXIT_FAILURE);
+  }
+  if (parameters->get_fixation_stop() > 0 && parameters->get_focal_sample_size() > 0)
+  {
+    std::cout << "Error: fixations cannot be detected in a focal sample.\n";
+    exit(EXIT_FAILURE);
+  }
+  if (parameters->get_focal_sample_size() > parameters->get_population_size())
+  {
+    std::cout << "Error: the focal sample cannot be larger than the population.\n";
+    exit(EXIT_FAILURE);
+  }
+  if (parameters->get_mutation_log() && (!parameters->get_lineage_tracking() || parameters->get_collapse_unary() || parameters->get_focal_sample_size() > 0))
+  {
+    std::cout << "Error: the mutation log requires the full lineage tree (-lineage without -collapse or -focal).\n";
+    exit(EXIT_FAILURE);
+  }
+}
+
+/**
+ * \brief    Read the paired parameter variants
+ * \details  Each "-pair option value" defines a variant: the command line
+ *           without the pairs, followed by "-option value". The base command
+ *           line is variant 0. All the variants share the seed of the base
+ *           parameters and run with common random numbers: the same event
+ *           draws the same numbers in every variant, so that differences
+ *           between variants have a low variance. Returns the base parameters
+ *           alone when there is no pair
+ * \param    int argc
+ * \param    char const** argv
+ * \param    Parameters* parameters
+ * \return   \e std::vector<Parameters*>
+ */
+std::vector<Parameters*> readVariants( int argc, char const** argv, Parameters* parameters )
+{
+  std::vector<Parameters*> variants(1, parameters);
+  if (!parameters->get_common_random_numbers())
+  {
+    return variants;
+  }
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 1) Split the pairs from the base   */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  std::vector<const char*> base_argv;
+  std::vector<int>         pairs;
+  for (int i = 0; i < argc; i++)
+  {
+    if (strcmp(argv[i], "-pair") == 0 || strcmp(argv[i], "--pair") == 0)
+    {
+      pairs.push_back(i);
+      i += 2;
+    }
+    else
+    {
+      base_argv.push_back(argv[i]);
+    }
+  }
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 2) Read each variant               */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  for (size_t v = 0; v < pairs.size(); v++)
+  {
+    std::string              option = std::string("-")+argv[pairs[v]+1];
+    std::vector<const char*> variant_argv(base_argv);
+    variant_argv.push_back(option.c_str());
+    variant_argv.push_back(argv[pairs[v]+2]);
+    Parameters* variant = new Parameters();
+    variant->set_common_random_numbers(true);
+    readArgs((int)variant_argv.size(), variant_argv.data(), variant);
+    variant->set_seed(parameters->get_seed());
+    variant->set_variant((int)v+1);
+    variants.push_back(variant);
+  }
+  return variants;
 }
 
 /**
@@ -485,6 +933,22 @@ void printUsage( void )
   std::cout << "        print the current version, then exit\n";
   std::cout << "  -seed, --seed\n";
   std::cout << "        specify the prng seed (mandatory, random if 0)\n";
+  std::cout << "  -replicates, --replicates\n";
+  std::cout << "        specify the number of replicates run in lockstep (1D only, replicate k uses seed+k)\n";
+  std::cout << "  -pair, --pair\n";
+  std::cout << "        add a paired variant of the command line, given as an option name without dash and its value\n";
+  std::cout << "        (e.g. -pair noise NONE). Variants share the seed and draw common random numbers: selection,\n";
+  std::cout << "        mutations and phenotypes of the same event use aligned keyed streams. Variant v writes\n";
+  std::cout << "        mean_variant_v.txt and sd_variant_v.txt, the base command line being variant 0\n";
+  std::cout << "  -prng, --prng\n";
+  std::cout << "        specify the main prng algorithm (MT19937/PHILOX/XOSHIRO/PCG, default MT19937)\n";
+  std::cout << "        only MT19937 reproduces the draws of previous versions, and only in two or more dimensions:\n";
+  std::cout << "        the one-dimensional engine draws mutations and phenotypes in a different order\n";
+  std::cout << "        with PHILOX, replicates and demes draw from non-overlapping keyed streams instead of derived seeds\n";
+  std::cout << "  -gaussian, --gaussian\n";
+  std::cout << "        specify how MT19937 generates blocks of phenotypic noise draws (ZIGGURAT/BOXMULLER, default ZIGGURAT)\n";
+  std::cout << "        BOXMULLER transforms blocks of uniforms with the numeric kernel; ZIGGURAT keeps the legacy draws\n";
+  std::cout << "        the other prng algorithms always use the numeric kernel\n";
   std::cout << "  -stabg, --stabilizing-generations\n";
   std::cout << "        specify the number of stabilizing generations\n";
   std::cout << "  -g, --generations\n";
@@ -513,6 +977,18 @@ void printUsage( void )
   std::cout << "        Indicates if the initial population is shifted in a single dimension\n";
   std::cout << "  -meanfitness, --mean-fitness\n";
   std::cout << "        Indicates if the mean fitness should be computed (by sampling the phenotypes)\n";
+  std::cout << "  -skipmono, --skip-monomorphic\n";
+  std::cout << "        Indicates if mutation-free generations of a monomorphic population should be skipped\n";
+  std::cout << "        (the waiting time until the next mutation is drawn; exact, but the prng stream changes)\n";
+  std::cout << "        (not compatible with lineage tracking, since coalescences are not drawn in skipped generations)\n";
+  std::cout << "        (skipped generations write the expected statistics of the monomorphic genotype)\n";
+  std::cout << "  -demes, --demes\n";
+  std::cout << "        specify the number of demes the population is split into (default 1)\n";
+  std::cout << "        each deme draws from its own prng stream, and demes run on the threads\n";
+  std::cout << "  -migrate, --migration-rate\n";
+  std::cout << "        specify the probability of migration of each individual (default 0.0)\n";
+  std::cout << "  -migint, --migration-interval\n";
+  std::cout << "        specify the number of generations between two migrations (default 1)\n";
   std::cout << "  -mmu, --m-mu\n";
   std::cout << "        specify mu mutation rate (mandatory)\n";
   std::cout << "  -msigma, --m-sigma\n";
@@ -527,16 +1003,58 @@ void printUsage( void )
   std::cout << "        specify theta mutation size (mandatory)\n";
   std::cout << "  -noise, --noise-type\n";
   std::cout << "        Specify the type of noise (mandatory, NONE/ISOTROPIC/UNCORRELATED/FULL)\n";
+  std::cout << "  -selection, --selection\n";
+  std::cout << "        specify the exact multinomial sampler drawing the offspring (GSL/BINOMIAL/SORTED/SPLITTING, default GSL)\n";
+  std::cout << "        only GSL reproduces the draws of previous versions; SPLITTING uses the threads when there are some\n";
+  std::cout << "  -model, --population-model\n";
+  std::cout << "        specify the population model (WF/MORAN, default WF)\n";
+  std::cout << "        with MORAN, each generation is made of N birth-death events\n";
+  std::cout << "  -lineage, --lineage-tracking\n";
+  std::cout << "        Indicates if the genealogy of the living population should be tracked\n";
+  std::cout << "        (the lineage of the best final individual is written in best_lineage.txt)\n";
+  std::cout << "        (the MRCA, the time to the MRCA and the number of fixed mutations are added to mean.txt)\n";
+  std::cout << "  -lineagelog, --lineage-log\n";
+  std::cout << "        Indicates if only the ancestral lineages of the living population should be kept, in a lightweight log\n";
+  std::cout << "        (best_lineage.txt is written as with -lineage; the other lineage options require -lineage)\n";
+  std::cout << "  -collapse, --collapse-unary\n";
+  std::cout << "        Indicates if dead ancestors with a single child should be removed from the lineage tree\n";
+  std::cout << "        (only coalescence points are kept, and written along the best lineage)\n";
+  std::cout << "  -genealogy, --genealogy-interval\n";
+  std::cout << "        specify the interval (in generations) at which the genealogy is streamed to disk (default 0 = none)\n";
+  std::cout << "        ancestors shared by the whole population are written in genealogy_nodes.bin and genealogy_edges.bin,\n";
+  std::cout << "        then removed from the lineage tree (best_lineage.txt then starts at the last export);\n";
+  std::cout << "        the remaining genealogy of the final population is written at the end (see SigmaFGM_genealogy)\n";
+  std::cout << "  -fixstop, --fixation-stop\n";
+  std::cout << "        specify the number of fixed beneficial mutations stopping the run (default 0 = none)\n";
+  std::cout << "        requires lineage tracking; a beneficial mutation is a mu mutation which increased W(mu) at birth\n";
+  std::cout << "  -focal, --focal-sample-size\n";
+  std::cout << "        specify the number of focal individuals whose lineages are tracked (default 0 = whole population)\n";
+  std::cout << "        requires -lineage or -lineagelog; the focal sample is drawn among the offspring of the previous one,\n";
+  std::cout << "        and restarted from new roots only when it is lost; the mrca, tmrca and fixation columns then\n";
+  std::cout << "        refer to the tree of the focal sample (incompatible with -fixstop)\n";
+  std::cout << "  -mutlog, --mutation-log\n";
+  std::cout << "        Indicates if mutation events should be logged in mutation_events.bin, and their fixation or loss\n";
+  std::cout << "        in mutation_fates.bin; fixation probabilities and times by effect size s = W(mu) after/before - 1\n";
+  std::cout << "        are written in mutation_fixation.txt (requires -lineage, without -collapse or -focal)\n";
+  std::cout << "  -threads, --threads\n";
+  std::cout << "        specify the number of threads computing the offspring (n > 1, default 0 = sequential)\n";
+  std::cout << "        with 1 thread or more, results do not depend on the number of threads\n";
+  std::cout << "  -pin, --pin-threads\n";
+  std::cout << "        Indicates if threads should be pinned to cores (each thread then keeps its shard of the population)\n";
+  std::cout << "  -hugepages, --hugepages\n";
+  std::cout << "        Indicates if large population buffers should be backed by (transparent) huge pages\n";
+  std::cout << "  -asyncout, --async-output\n";
+  std::cout << "        Indicates if statistics should be written by an output thread, overlapping the next generations\n";
   std::cout << "\n";
 }
 
 /**
  * \brief    Print header
- * \details  --
- * \param    void
+ * \details  Records the numeric kernels and the prng engine of the run
+ * \param    Parameters* parameters
  * \return   \e void
  */
-void printHeader( void )
+void printHeader( Parameters* parameters )
 {
   std::cout << "\n";
   std::cout << "*********************************************************************\n";
@@ -555,5 +1073,7 @@ void printHeader( void )
   std::cout << " This is free software, and you are welcome to redistribute it under \n";
   std::cout << " certain conditions; See the GNU General Public License for details  \n";
   std::cout << "*********************************************************************\n";
+  std::cout << " Numeric kernels: " << Kernels::get_isa_name() << "\n";
+  std::cout << " Prng engine:     " << Prng::get_type_name(parameters->get_prng_type()) << "\n";
   std::cout << "\n";
 }
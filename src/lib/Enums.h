@@ -68,5 +68,112 @@ enum node_state
   ALIVE = 2  /*!< The individual is alive */
 };
 
+/******************************************************************************************/
+
+/**
+ * \brief   Kernels instruction set
+ * \details Defines the instruction set the numeric kernels are compiled for.
+ */
+enum kernel_isa
+{
+  GENERIC = 0, /*!< Portable scalar code        */
+  SSE2    = 1, /*!< x86-64 baseline (SSE2)      */
+  AVX2    = 2, /*!< AVX2 and FMA                */
+  AVX512  = 3  /*!< AVX-512 foundation          */
+};
+
+/******************************************************************************************/
+
+/**
+ * \brief   Selection sampler
+ * \details Defines the exact multinomial sampler used to draw the number of offspring.
+ */
+enum selection_sampler
+{
+  GSL_MULTINOMIAL      = 0, /*!< gsl_ran_multinomial on normalized weights          */
+  CONDITIONAL_BINOMIAL = 1, /*!< Conditional binomials on unnormalized weights      */
+  SORTED_UNIFORMS      = 2, /*!< Sorted uniforms (exponential spacings) walk        */
+  BINOMIAL_SPLITTING   = 3  /*!< Recursive binomial splitting over parallel blocks */
+};
+
+/******************************************************************************************/
+
+/**
+ * \brief   Population model
+ * \details Defines how the population is renewed.
+ */
+enum population_model
+{
+  WRIGHT_FISHER = 0, /*!< Synchronized non-overlapping generations */
+  MORAN         = 1  /*!< Overlapping generations (birth-death)    */
+};
+
+/******************************************************************************************/
+
+/**
+ * \brief   Statistic
+ * \details Defines the variables accumulated over the individuals to compute statistics.
+ */
+enum statistic
+{
+  DMU_STATISTIC             = 0, /*!< Genetic distance                 */
+  DZ_STATISTIC              = 1, /*!< Phenotypic distance              */
+  WMU_STATISTIC             = 2, /*!< Genetic fitness                  */
+  WZ_STATISTIC              = 3, /*!< Phenotypic fitness               */
+  EV_STATISTIC              = 4, /*!< Best eigen value                 */
+  EV_CONTRIBUTION_STATISTIC = 5, /*!< Best eigen value contribution    */
+  EV_DOT_PRODUCT_STATISTIC  = 6, /*!< Best dot product                 */
+  R_MU_STATISTIC            = 7, /*!< Euclidean size of mu mutation    */
+  R_SIGMA_STATISTIC         = 8, /*!< Euclidean size of sigma mutation */
+  R_THETA_STATISTIC         = 9  /*!< Euclidean size of theta mutation */
+};
+
+/******************************************************************************************/
+
+/**
+ * \brief   Prng type
+ * \details Defines the algorithm of the main pseudorandom numbers generators.
+ */
+enum prng_type
+{
+  MT19937      = 0, /*!< Mersenne twister (sequential state)        */
+  PHILOX       = 1, /*!< Philox4x32-10 counter-based keyed streams */
+  XOSHIRO256PP = 2, /*!< xoshiro256++ (small state)                */
+  PCG64        = 3  /*!< PCG64 (128-bit LCG with permuted output)  */
+};
+
+/******************************************************************************************/
+
+/**
+ * \brief   Gaussian sampler
+ * \details Defines how blocks of N(0,1) draws are generated by MT19937. The
+ *          other algorithms always transform blocks of uniforms.
+ */
+enum gaussian_sampler
+{
+  ZIGGURAT   = 0, /*!< GSL ziggurat, one value at a time (legacy draws) */
+  BOX_MULLER = 1  /*!< Block of uniforms transformed by the kernel      */
+};
+
+/******************************************************************************************/
+
+/**
+ * \brief   Prng stream
+ * \details Defines the purpose of a keyed counter-based stream.
+ */
+enum prng_stream
+{
+  MAIN_STREAM        = 0, /*!< Sequential stream of a population or replicate */
+  DEME_STREAM        = 1, /*!< Sequential stream of a deme                    */
+  OFFSPRING_STREAM   = 2, /*!< Mutations and phenotype of one offspring       */
+  SELECTION_STREAM   = 3, /*!< Selection draws of one generation              */
+  MUTATION_STREAM    = 4, /*!< Mutations of one offspring                     */
+  PHENOTYPE_STREAM   = 5, /*!< Phenotype of one offspring                     */
+  INITIAL_STREAM     = 6, /*!< Initial phenotype of one individual            */
+  FOCAL_STREAM       = 7, /*!< Sampling of the focal individuals              */
+  BLOCK_STREAM       = 8, /*!< Conditional binomials of one selection block   */
+  MONOMORPHIC_STREAM = 9  /*!< Phenotypes of a skipped monomorphic generation */
+};
+
 
 #endif /* defined(__SigmaFGM__Enums__) */
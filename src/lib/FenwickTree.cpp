@@ -0,0 +1,170 @@
+
+/**
+ * \file      FenwickTree.cpp
+ * \authors   Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * \date      18-10-2026
+ * \copyright Copyright (C) 2016-2020 Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard. All rights reserved
+ * \license   This project is released under the GNU General Public License
+ * \brief     FenwickTree class definition
+ */
+
+/***********************************************************************
+ * Copyright (C) 2016-2020
+ * Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * Web: https://github.com/charlesrocabert/SigmaFGM/
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#include "FenwickTree.h"
+
+
+/*----------------------------
+ * CONSTRUCTORS
+ *----------------------------*/
+
+/**
+ * \brief    Constructor
+ * \details  All the weights are set to zero
+ * \param    int size
+ * \return   \e void
+ */
+FenwickTree::FenwickTree( int size )
+{
+  assert(size > 0);
+  _size    = size;
+  _step    = 1;
+  while (_step*2 <= _size)
+  {
+    _step *= 2;
+  }
+  _weights = new double[_size];
+  _tree    = new double[_size+1];
+  _total   = 0.0;
+  for (int i = 0; i < _size; i++)
+  {
+    _weights[i] = 0.0;
+  }
+  for (int i = 0; i <= _size; i++)
+  {
+    _tree[i] = 0.0;
+  }
+}
+
+/*----------------------------
+ * DESTRUCTORS
+ *----------------------------*/
+
+/**
+ * \brief    Destructor
+ * \details  --
+ * \param    void
+ * \return   \e void
+ */
+FenwickTree::~FenwickTree( void )
+{
+  delete[] _weights;
+  _weights = NULL;
+  delete[] _tree;
+  _tree = NULL;
+}
+
+/*----------------------------
+ * SETTERS
+ *----------------------------*/
+
+/**
+ * \brief    Set weight i
+ * \details  Updates the partial sums in O(log N)
+ * \param    int i
+ * \param    double weight
+ * \return   \e void
+ */
+void FenwickTree::set_weight( int i, double weight )
+{
+  assert(i >= 0);
+  assert(i < _size);
+  assert(weight >= 0.0);
+  double delta  = weight-_weights[i];
+  _weights[i]   = weight;
+  _total       += delta;
+  for (int j = i+1; j <= _size; j += (j & -j))
+  {
+    _tree[j] += delta;
+  }
+}
+
+/*----------------------------
+ * PUBLIC METHODS
+ *----------------------------*/
+
+/**
+ * \brief    Build the tree from a weights vector
+ * \details  Runs in O(N). Rebuilding regularly also clears the rounding
+ *           errors accumulated by set_weight()
+ * \param    const double* weights
+ * \return   \e void
+ */
+void FenwickTree::build( const double* weights )
+{
+  _tree[0] = 0.0;
+  _total   = 0.0;
+  for (int i = 0; i < _size; i++)
+  {
+    assert(weights[i] >= 0.0);
+    _weights[i]  = weights[i];
+    _tree[i+1]   = weights[i];
+    _total      += weights[i];
+  }
+  for (int j = 1; j <= _size; j++)
+  {
+    int parent = j+(j & -j);
+    if (parent <= _size)
+    {
+      _tree[parent] += _tree[j];
+    }
+  }
+}
+
+/**
+ * \brief    Sample an index with a probability proportional to its weight
+ * \details  Returns the index i such that the sum of the weights before i is
+ *           lower or equal to u, and the sum including i is greater than u.
+ *           u must be drawn uniformly in [0, total[. Runs in O(log N)
+ * \param    double u
+ * \return   \e int
+ */
+int FenwickTree::sample( double u ) const
+{
+  assert(_total > 0.0);
+  int position = 0;
+  for (int step = _step; step > 0; step /= 2)
+  {
+    if (position+step <= _size && _tree[position+step] <= u)
+    {
+      position += step;
+      u        -= _tree[position];
+    }
+  }
+  /*** Rounding errors may push u past the last weight ***/
+  if (position == _size)
+  {
+    position--;
+    while (position > 0 && _weights[position] <= 0.0)
+    {
+      position--;
+    }
+  }
+  return position;
+}
@@ -0,0 +1,141 @@
+
+/**
+ * \file      FenwickTree.h
+ * \authors   Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * \date      18-10-2026
+ * \copyright Copyright (C) 2016-2020 Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard. All rights reserved
+ * \license   This project is released under the GNU General Public License
+ * \brief     FenwickTree class declaration
+ */
+
+/***********************************************************************
+ * Copyright (C) 2016-2020
+ * Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * Web: https://github.com/charlesrocabert/SigmaFGM/
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#ifndef __SigmaFGM__FenwickTree__
+#define __SigmaFGM__FenwickTree__
+
+#include <iostream>
+#include <assert.h>
+
+#include "Macros.h"
+
+
+class FenwickTree
+{
+  
+public:
+  
+  /*----------------------------
+   * CONSTRUCTORS
+   *----------------------------*/
+  FenwickTree( void ) = delete;
+  FenwickTree( int size );
+  FenwickTree( const FenwickTree& tree ) = delete;
+  
+  /*----------------------------
+   * DESTRUCTORS
+   *----------------------------*/
+  ~FenwickTree( void );
+  
+  /*----------------------------
+   * GETTERS
+   *----------------------------*/
+  inline int    get_size( void ) const;
+  inline double get_weight( int i ) const;
+  inline double get_total( void ) const;
+  
+  /*----------------------------
+   * SETTERS
+   *----------------------------*/
+  FenwickTree& operator=(const FenwickTree&) = delete;
+  
+  void set_weight( int i, double weight );
+  
+  /*----------------------------
+   * PUBLIC METHODS
+   *----------------------------*/
+  void build( const double* weights );
+  int  sample( double u ) const;
+  
+  /*----------------------------
+   * PUBLIC ATTRIBUTES
+   *----------------------------*/
+  
+protected:
+  
+  /*----------------------------
+   * PROTECTED METHODS
+   *----------------------------*/
+  
+  /*----------------------------
+   * PROTECTED ATTRIBUTES
+   *----------------------------*/
+  int     _size;    /*!< Number of weights                               */
+  int     _step;    /*!< Largest power of two lower or equal to the size */
+  double* _weights; /*!< Weights                                         */
+  double* _tree;    /*!< Partial sums (1-based binary indexed tree)      */
+  double  _total;   /*!< Sum of the weights                              */
+};
+
+
+/*----------------------------
+ * GETTERS
+ *----------------------------*/
+
+/**
+ * \brief    Get the number of weights
+ * \details  --
+ * \param    void
+ * \return   \e int
+ */
+inline int FenwickTree::get_size( void ) const
+{
+  return _size;
+}
+
+/**
+ * \brief    Get weight i
+ * \details  --
+ * \param    int i
+ * \return   \e double
+ */
+inline double FenwickTree::get_weight( int i ) const
+{
+  assert(i >= 0);
+  assert(i < _size);
+  return _weights[i];
+}
+
+/**
+ * \brief    Get the sum of the weights
+ * \details  --
+ * \param    void
+ * \return   \e double
+ */
+inline double FenwickTree::get_total( void ) const
+{
+  return _total;
+}
+
+/*----------------------------
+ * SETTERS
+ *----------------------------*/
+
+
+#endif /* defined(__SigmaFGM__FenwickTree__) */
@@ -0,0 +1,119 @@
+
+/**
+ * \file      GenealogyReader.cpp
+ * \authors   Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * \date      18-10-2026
+ * \copyright Copyright (C) 2016-2020 Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard. All rights reserved
+ * \license   This project is released under the GNU General Public License
+ * \brief     GenealogyReader class definition
+ */
+
+/***********************************************************************
+ * Copyright (C) 2016-2020
+ * Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * Web: https://github.com/charlesrocabert/SigmaFGM/
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#include "GenealogyReader.h"
+
+
+/*----------------------------
+ * CONSTRUCTORS
+ *----------------------------*/
+
+/**
+ * \brief    Constructor
+ * \details  Opens both tables and checks their headers (see GenealogyWriter)
+ * \param    std::string nodes_filename
+ * \param    std::string edges_filename
+ * \return   \e void
+ */
+GenealogyReader::GenealogyReader( std::string nodes_filename, std::string edges_filename )
+{
+  open_table(_nodes_file, nodes_filename, "SFGMNODE", (uint32_t)sizeof(genealogy_node));
+  open_table(_edges_file, edges_filename, "SFGMEDGE", (uint32_t)sizeof(genealogy_edge));
+}
+
+/*----------------------------
+ * DESTRUCTORS
+ *----------------------------*/
+
+/**
+ * \brief    Destructor
+ * \details  --
+ * \param    void
+ * \return   \e void
+ */
+GenealogyReader::~GenealogyReader( void )
+{
+  _nodes_file.close();
+  _edges_file.close();
+}
+
+/*----------------------------
+ * PUBLIC METHODS
+ *----------------------------*/
+
+/**
+ * \brief    Read the next node row
+ * \details  Return false at the end of the table
+ * \param    genealogy_node& node
+ * \return   \e bool
+ */
+bool GenealogyReader::read_node( genealogy_node& node )
+{
+  return (bool)_nodes_file.read((char*)&node, sizeof(genealogy_node));
+}
+
+/**
+ * \brief    Read the next edge row
+ * \details  Return false at the end of the table
+ * \param    genealogy_edge& edge
+ * \return   \e bool
+ */
+bool GenealogyReader::read_edge( genealogy_edge& edge )
+{
+  return (bool)_edges_file.read((char*)&edge, sizeof(genealogy_edge));
+}
+
+/*----------------------------
+ * PROTECTED METHODS
+ *----------------------------*/
+
+/**
+ * \brief    Open a table and check its header
+ * \details  --
+ * \param    std::ifstream& file
+ * \param    std::string filename
+ * \param    const char* magic
+ * \param    uint32_t row_size
+ * \return   \e void
+ */
+void GenealogyReader::open_table( std::ifstream& file, std::string filename, const char* magic, uint32_t row_size )
+{
+  file.open(filename, std::ios::in | std::ios::binary);
+  if (!file.is_open())
+  {
+    std::cout << "Error: cannot open the genealogy table " << filename << ".\n";
+    exit(EXIT_FAILURE);
+  }
+  genealogy_header header;
+  if (!file.read((char*)&header, sizeof(genealogy_header)) || memcmp(header.magic, magic, 8) != 0 || header.version != GENEALOGY_VERSION || header.row_size != row_size)
+  {
+    std::cout << "Error: " << filename << " is not a genealogy table of this version.\n";
+    exit(EXIT_FAILURE);
+  }
+}
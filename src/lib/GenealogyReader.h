@@ -0,0 +1,105 @@
+
+/**
+ * \file      GenealogyReader.h
+ * \authors   Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * \date      18-10-2026
+ * \copyright Copyright (C) 2016-2020 Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard. All rights reserved
+ * \license   This project is released under the GNU General Public License
+ * \brief     GenealogyReader class declaration
+ */
+
+/***********************************************************************
+ * Copyright (C) 2016-2020
+ * Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * Web: https://github.com/charlesrocabert/SigmaFGM/
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#ifndef __SigmaFGM__GenealogyReader__
+#define __SigmaFGM__GenealogyReader__
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <assert.h>
+
+#include "Macros.h"
+#include "Enums.h"
+#include "Structs.h"
+
+
+class GenealogyReader
+{
+  
+public:
+  
+  /*----------------------------
+   * CONSTRUCTORS
+   *----------------------------*/
+  GenealogyReader( void ) = delete;
+  GenealogyReader( std::string nodes_filename, std::string edges_filename );
+  GenealogyReader( const GenealogyReader& reader ) = delete;
+  
+  /*----------------------------
+   * DESTRUCTORS
+   *----------------------------*/
+  ~GenealogyReader( void );
+  
+  /*----------------------------
+   * GETTERS
+   *----------------------------*/
+  
+  /*----------------------------
+   * SETTERS
+   *----------------------------*/
+  GenealogyReader& operator=(const GenealogyReader&) = delete;
+  
+  /*----------------------------
+   * PUBLIC METHODS
+   *----------------------------*/
+  bool read_node( genealogy_node& node );
+  bool read_edge( genealogy_edge& edge );
+  
+  /*----------------------------
+   * PUBLIC ATTRIBUTES
+   *----------------------------*/
+  
+protected:
+  
+  /*----------------------------
+   * PROTECTED METHODS
+   *----------------------------*/
+  void open_table( std::ifstream& file, std::string filename, const char* magic, uint32_t row_size );
+  
+  /*----------------------------
+   * PROTECTED ATTRIBUTES
+   *----------------------------*/
+  std::ifstream _nodes_file; /*!< Node table file */
+  std::ifstream _edges_file; /*!< Edge table file */
+};
+
+
+/*----------------------------
+ * GETTERS
+ *----------------------------*/
+
+/*----------------------------
+ * SETTERS
+ *----------------------------*/
+
+
+#endif /* defined(__SigmaFGM__GenealogyReader__) */
@@ -0,0 +1,175 @@
+
+/**
+ * \file      GenealogyWriter.cpp
+ * \authors   Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * \date      18-10-2026
+ * \copyright Copyright (C) 2016-2020 Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard. All rights reserved
+ * \license   This project is released under the GNU General Public License
+ * \brief     GenealogyWriter class definition
+ */
+
+/***********************************************************************
+ * Copyright (C) 2016-2020
+ * Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * Web: https://github.com/charlesrocabert/SigmaFGM/
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#include "GenealogyWriter.h"
+
+
+/*----------------------------
+ * CONSTRUCTORS
+ *----------------------------*/
+
+/**
+ * \brief    Constructor
+ * \details  Opens both tables and writes their headers. Rows are streamed
+ *           in host byte order: a node row is 96 bytes (identifier, birth
+ *           generation, flags and the values of the lineage record), an edge
+ *           row is 16 bytes (parent and child identifiers)
+ * \param    std::string nodes_filename
+ * \param    std::string edges_filename
+ * \return   \e void
+ */
+GenealogyWriter::GenealogyWriter( std::string nodes_filename, std::string edges_filename )
+{
+  _number_of_nodes = 0;
+  _number_of_edges = 0;
+  open_table(_nodes_file, nodes_filename, "SFGMNODE", (uint32_t)sizeof(genealogy_node));
+  open_table(_edges_file, edges_filename, "SFGMEDGE", (uint32_t)sizeof(genealogy_edge));
+}
+
+/*----------------------------
+ * DESTRUCTORS
+ *----------------------------*/
+
+/**
+ * \brief    Destructor
+ * \details  --
+ * \param    void
+ * \return   \e void
+ */
+GenealogyWriter::~GenealogyWriter( void )
+{
+  close();
+}
+
+/*----------------------------
+ * PUBLIC METHODS
+ *----------------------------*/
+
+/**
+ * \brief    Write a node row
+ * \details  --
+ * \param    const lineage_record& record
+ * \param    uint32_t flags
+ * \return   \e void
+ */
+void GenealogyWriter::write_node( const lineage_record& record, uint32_t flags )
+{
+  assert(_nodes_file.is_open());
+  genealogy_node row;
+  row.identifier     = (uint64_t)record.identifier;
+  row.generation     = (int32_t)record.generation;
+  row.flags          = flags;
+  row.dmu            = record.dmu;
+  row.dz             = record.dz;
+  row.Wmu            = record.Wmu;
+  row.Wz             = record.Wz;
+  row.EV             = record.EV;
+  row.EV_contrib     = record.EV_contrib;
+  row.EV_dot_product = record.EV_dot_product;
+  row.r_mu           = record.r_mu;
+  row.r_sigma        = record.r_sigma;
+  row.r_theta        = record.r_theta;
+  _nodes_file.write((const char*)&row, sizeof(genealogy_node));
+  _number_of_nodes++;
+}
+
+/**
+ * \brief    Write an edge row
+ * \details  --
+ * \param    unsigned long long int parent
+ * \param    unsigned long long int child
+ * \return   \e void
+ */
+void GenealogyWriter::write_edge( unsigned long long int parent, unsigned long long int child )
+{
+  assert(_edges_file.is_open());
+  genealogy_edge row;
+  row.parent = (uint64_t)parent;
+  row.child  = (uint64_t)child;
+  _edges_file.write((const char*)&row, sizeof(genealogy_edge));
+  _number_of_edges++;
+}
+
+/**
+ * \brief    Flush both tables
+ * \details  --
+ * \param    void
+ * \return   \e void
+ */
+void GenealogyWriter::flush( void )
+{
+  _nodes_file.flush();
+  _edges_file.flush();
+}
+
+/**
+ * \brief    Close both tables
+ * \details  --
+ * \param    void
+ * \return   \e void
+ */
+void GenealogyWriter::close( void )
+{
+  if (_nodes_file.is_open())
+  {
+    _nodes_file.close();
+  }
+  if (_edges_file.is_open())
+  {
+    _edges_file.close();
+  }
+}
+
+/*----------------------------
+ * PROTECTED METHODS
+ *----------------------------*/
+
+/**
+ * \brief    Open a table and write its header
+ * \details  --
+ * \param    std::ofstream& file
+ * \param    std::string filename
+ * \param    const char* magic
+ * \param    uint32_t row_size
+ * \return   \e void
+ */
+void GenealogyWriter::open_table( std::ofstream& file, std::string filename, const char* magic, uint32_t row_size )
+{
+  file.open(filename, std::ios::out | std::ios::trunc | std::ios::binary);
+  if (!file.is_open())
+  {
+    std::cout << "Error: cannot open the genealogy table " << filename << ".\n";
+    exit(EXIT_FAILURE);
+  }
+  genealogy_header header;
+  memcpy(header.magic, magic, 8);
+  header.version  = GENEALOGY_VERSION;
+  header.row_size = row_size;
+  file.write((const char*)&header, sizeof(genealogy_header));
+}
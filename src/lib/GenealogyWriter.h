@@ -0,0 +1,133 @@
+
+/**
+ * \file      GenealogyWriter.h
+ * \authors   Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * \date      18-10-2026
+ * \copyright Copyright (C) 2016-2020 Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard. All rights reserved
+ * \license   This project is released under the GNU General Public License
+ * \brief     GenealogyWriter class declaration
+ */
+
+/***********************************************************************
+ * Copyright (C) 2016-2020
+ * Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * Web: https://github.com/charlesrocabert/SigmaFGM/
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#ifndef __SigmaFGM__GenealogyWriter__
+#define __SigmaFGM__GenealogyWriter__
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <assert.h>
+
+#include "Macros.h"
+#include "Enums.h"
+#include "Structs.h"
+
+
+class GenealogyWriter
+{
+  
+public:
+  
+  /*----------------------------
+   * CONSTRUCTORS
+   *----------------------------*/
+  GenealogyWriter( void ) = delete;
+  GenealogyWriter( std::string nodes_filename, std::string edges_filename );
+  GenealogyWriter( const GenealogyWriter& writer ) = delete;
+  
+  /*----------------------------
+   * DESTRUCTORS
+   *----------------------------*/
+  ~GenealogyWriter( void );
+  
+  /*----------------------------
+   * GETTERS
+   *----------------------------*/
+  inline unsigned long long int get_number_of_nodes( void ) const;
+  inline unsigned long long int get_number_of_edges( void ) const;
+  
+  /*----------------------------
+   * SETTERS
+   *----------------------------*/
+  GenealogyWriter& operator=(const GenealogyWriter&) = delete;
+  
+  /*----------------------------
+   * PUBLIC METHODS
+   *----------------------------*/
+  void write_node( const lineage_record& record, uint32_t flags );
+  void write_edge( unsigned long long int parent, unsigned long long int child );
+  void flush( void );
+  void close( void );
+  
+  /*----------------------------
+   * PUBLIC ATTRIBUTES
+   *----------------------------*/
+  
+protected:
+  
+  /*----------------------------
+   * PROTECTED METHODS
+   *----------------------------*/
+  void open_table( std::ofstream& file, std::string filename, const char* magic, uint32_t row_size );
+  
+  /*----------------------------
+   * PROTECTED ATTRIBUTES
+   *----------------------------*/
+  std::ofstream          _nodes_file;      /*!< Node table file         */
+  std::ofstream          _edges_file;      /*!< Edge table file         */
+  unsigned long long int _number_of_nodes; /*!< Number of nodes written */
+  unsigned long long int _number_of_edges; /*!< Number of edges written */
+};
+
+
+/*----------------------------
+ * GETTERS
+ *----------------------------*/
+
+/**
+ * \brief    Get the number of nodes written
+ * \details  --
+ * \param    void
+ * \return   \e unsigned long long int
+ */
+inline unsigned long long int GenealogyWriter::get_number_of_nodes( void ) const
+{
+  return _number_of_nodes;
+}
+
+/**
+ * \brief    Get the number of edges written
+ * \details  --
+ * \param    void
+ * \return   \e unsigned long long int
+ */
+inline unsigned long long int GenealogyWriter::get_number_of_edges( void ) const
+{
+  return _number_of_edges;
+}
+
+/*----------------------------
+ * SETTERS
+ *----------------------------*/
+
+
+#endif /* defined(__SigmaFGM__GenealogyWriter__) */
@@ -30,6 +30,61 @@
 #include "Individual.h"
 
 
+/**
+ * \brief   Sigma workspace
+ * \details Matrices and vectors used to build Sigma. They are shared by all
+ *          the individuals of a thread and only reallocated when the number
+ *          of dimensions changes
+ */
+struct sigma_workspace
+{
+  int         n;           /*!< Number of dimensions        */
+  gsl_matrix* X;           /*!< Eigen vectors matrix        */
+  gsl_matrix* D;           /*!< Eigen values matrix         */
+  gsl_matrix* P;           /*!< Matrix product D * X^T      */
+  gsl_matrix* Sigma;       /*!< Co-variance matrix          */
+  gsl_vector* eigenvector; /*!< Maximum eigen vector        */
+  gsl_vector* d;           /*!< Normalized optimum direction */
+  
+  sigma_workspace( void ) : n(0), X(NULL), D(NULL), P(NULL), Sigma(NULL), eigenvector(NULL), d(NULL) {}
+  ~sigma_workspace( void ) { release(); }
+  
+  void release( void )
+  {
+    gsl_matrix_free(X);
+    gsl_matrix_free(D);
+    gsl_matrix_free(P);
+    gsl_matrix_free(Sigma);
+    gsl_vector_free(eigenvector);
+    gsl_vector_free(d);
+    X           = NULL;
+    D           = NULL;
+    P           = NULL;
+    Sigma       = NULL;
+    eigenvector = NULL;
+    d           = NULL;
+    n           = 0;
+  }
+  
+  void resize( int new_n )
+  {
+    if (new_n != n)
+    {
+      release();
+      n           = new_n;
+      X           = gsl_matrix_alloc(n, n);
+      D           = gsl_matrix_alloc(n, n);
+      P           = gsl_matrix_alloc(n, n);
+      Sigma       = gsl_matrix_alloc(n, n);
+      eigenvector = gsl_vector_alloc(n);
+      d           = gsl_vector_alloc(n);
+    }
+  }
+};
+
+static thread_local sigma_workspace workspace;
+
+
 /*----------------------------
  * CONSTRUCTORS
  *----------------------------*/
@@ -60,6 +115,7 @@ Individual::Individual( Prng* prng, int n, double mu_init, double sigma_init, do
   
   _identifier = 0;
   _generation = 0;
+  _node       = NO_NODE;
   
   /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
   /* 1) Initialize matrices        */
@@ -132,6 +188,7 @@ Individual::Individual( Prng* prng, int n, double mu_init, double sigma_init, do
   _r_mu    = 0.0;
   _r_sigma = 0.0;
   _r_theta = 0.0;
+  allocate_buffers();
 }
 
 /**
@@ -153,6 +210,7 @@ Individual::Individual( const Individual& individual )
   
   _identifier = individual._identifier;
   _generation = individual._generation;
+  _node       = individual._node;
   
   /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
   /* 1) Initialize matrices        */
@@ -213,6 +271,7 @@ Individual::Individual( const Individual& individual )
   _r_mu    = individual._r_mu;
   _r_sigma = individual._r_sigma;
   _r_theta = individual._r_theta;
+  allocate_buffers();
 }
 
 /*----------------------------
@@ -229,32 +288,101 @@ Individual::~Individual( void )
 {
   _prng  = NULL;
   _z_opt = NULL;
-  gsl_vector_free(_mu);
-  _mu = NULL;
+  delete_vectors_and_matrices();
+}
+
+/*----------------------------
+ * PUBLIC METHODS
+ *----------------------------*/
+
+/**
+ * \brief    Copy an individual into this one
+ * \details  Vectors are copied into the existing buffers, so that no memory
+ *           is allocated. Both individuals must share the same number of
+ *           dimensions and noise type. As with the copy constructor, the
+ *           phenotype must be built again
+ * \param    const Individual& individual
+ * \return   \e void
+ */
+void Individual::copy( const Individual& individual )
+{
+  assert(_n == individual._n);
+  assert(_noise_type == individual._noise_type);
+  
+  /*----------------------------------------------- PARAMETERS */
+  
+  _prng  = individual._prng;
+  _z_opt = individual._z_opt;
+  
+  /*----------------------------------------------- VARIABLES */
+  
+  _identifier = individual._identifier;
+  _generation = individual._generation;
+  _node       = individual._node;
+  gsl_vector_memcpy(_mu, individual._mu);
   if (_noise_type != NONE)
   {
-    gsl_vector_free(_sigma);
-    _sigma = NULL;
-    gsl_matrix_free(_Sigma);
-    _Sigma = NULL;
-    gsl_matrix_free(_Cholesky);
-    _Cholesky = NULL;
-    gsl_vector_free(_max_Sigma_eigenvector);
-    _max_Sigma_eigenvector = NULL;
-    if (_n > 1 && _noise_type == FULL)
+    gsl_vector_memcpy(_sigma, individual._sigma);
+  }
+  if (_n > 1 && _noise_type == FULL)
+  {
+    gsl_vector_memcpy(_theta, individual._theta);
+  }
+  gsl_vector_memcpy(_z, individual._z);
+  _dmu = individual._dmu;
+  _dz  = individual._dz;
+  _Wmu = individual._Wmu;
+  _Wz  = individual._Wz;
+  
+  /*----------------------------------------------- MAPPING PROPERTIES */
+  
+  _phenotype_is_built     = false;
+  _max_Sigma_eigenvalue   = individual._max_Sigma_eigenvalue;
+  _max_Sigma_contribution = individual._max_Sigma_contribution;
+  _max_dot_product        = individual._max_dot_product;
+  
+  /*----------------------------------------------- MUTATIONS */
+  
+  _r_mu    = individual._r_mu;
+  _r_sigma = individual._r_sigma;
+  _r_theta = individual._r_theta;
+}
+
+/**
+ * \brief    Indicates if both individuals carry the same genotype
+ * \details  Compares mu, sigma and theta exactly: descendants of a same
+ *           individual that did not mutate are bitwise identical
+ * \param    const Individual& individual
+ * \return   \e bool
+ */
+bool Individual::has_same_genotype( const Individual& individual ) const
+{
+  assert(_n == individual._n);
+  assert(_noise_type == individual._noise_type);
+  for (int i = 0; i < _n; i++)
+  {
+    if (gsl_vector_get(_mu, i) != gsl_vector_get(individual._mu, i))
     {
-      gsl_vector_free(_theta);
-      _theta = NULL;
+      return false;
+    }
+    if (_noise_type != NONE && gsl_vector_get(_sigma, i) != gsl_vector_get(individual._sigma, i))
+    {
+      return false;
     }
   }
-  gsl_vector_free(_z);
-  _z = NULL;
+  if (_n > 1 && _noise_type == FULL)
+  {
+    for (int i = 0; i < _n*(_n-1)/2; i++)
+    {
+      if (gsl_vector_get(_theta, i) != gsl_vector_get(individual._theta, i))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
 }
 
-/*----------------------------
- * PUBLIC METHODS
- *----------------------------*/
-
 /**
  * \brief    Mutate the individual genotype
  * \details  --
@@ -268,23 +396,16 @@ Individual::~Individual( void )
  */
 void Individual::mutate( double m_mu, double m_sigma, double m_theta, double s_mu, double s_sigma, double s_theta )
 {
-  gsl_vector* previous_mu    = NULL;
-  gsl_vector* previous_sigma = NULL;
-  gsl_vector* previous_theta = NULL;
-  
   /*~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
   /* 1) Save current genotype  */
   /*~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
-  previous_mu = gsl_vector_alloc(_n);
-  gsl_vector_memcpy(previous_mu, _mu);
+  gsl_vector_memcpy(_previous_mu, _mu);
   if (_noise_type != NONE)
   {
-    previous_sigma = gsl_vector_alloc(_n);
-    gsl_vector_memcpy(previous_sigma, _sigma);
+    gsl_vector_memcpy(_previous_sigma, _sigma);
     if (_n > 1 && _noise_type == FULL)
     {
-      previous_theta = gsl_vector_alloc(_n*(_n-1)/2);
-      gsl_vector_memcpy(previous_theta, _theta);
+      gsl_vector_memcpy(_previous_theta, _theta);
     }
   }
   
@@ -340,12 +461,12 @@ void Individual::mutate( double m_mu, double m_sigma, double m_theta, double s_m
   _r_theta = 0.0;
   for (int i = 0; i < _n; i++)
   {
-    double p_mu  = gsl_vector_get(previous_mu, i);
+    double p_mu  = gsl_vector_get(_previous_mu, i);
     double mu    = gsl_vector_get(_mu, i);
     _r_mu       += (mu-p_mu)*(mu-p_mu);
     if (_noise_type != NONE)
     {
-      double p_sigma  = gsl_vector_get(previous_sigma, i);
+      double p_sigma  = gsl_vector_get(_previous_sigma, i);
       double sigma    = gsl_vector_get(_sigma, i);
       _r_sigma       += (sigma-p_sigma)*(sigma-p_sigma);
     }
@@ -354,7 +475,7 @@ void Individual::mutate( double m_mu, double m_sigma, double m_theta, double s_m
   {
     for (int i = 0; i < _n*(_n-1)/2; i++)
     {
-      double p_theta  = gsl_vector_get(previous_theta, i);
+      double p_theta  = gsl_vector_get(_previous_theta, i);
       double theta    = gsl_vector_get(_theta, i);
       _r_theta       += (theta-p_theta)*(theta-p_theta);
     }
@@ -362,16 +483,6 @@ void Individual::mutate( double m_mu, double m_sigma, double m_theta, double s_m
   _r_mu    = sqrt(_r_mu);
   _r_sigma = sqrt(_r_sigma);
   _r_theta = sqrt(_r_theta);
-  
-  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
-  /* 6) Free memory            */
-  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
-  gsl_vector_free(previous_mu);
-  previous_mu = NULL;
-  gsl_vector_free(previous_sigma);
-  previous_sigma = NULL;
-  gsl_vector_free(previous_theta);
-  previous_theta = NULL;
 }
 
 /**
@@ -454,24 +565,27 @@ void Individual::delete_vectors_and_matrices( void )
 {
   gsl_vector_free(_mu);
   _mu = NULL;
+  gsl_vector_free(_previous_mu);
+  _previous_mu = NULL;
   if (_noise_type != NONE)
   {
     gsl_vector_free(_sigma);
     _sigma = NULL;
-    gsl_matrix_free(_Sigma);
-    _Sigma = NULL;
+    gsl_vector_free(_previous_sigma);
+    _previous_sigma = NULL;
     gsl_matrix_free(_Cholesky);
     _Cholesky = NULL;
-    gsl_vector_free(_max_Sigma_eigenvector);
-    _max_Sigma_eigenvector = NULL;
     if (_n > 1 && _noise_type == FULL)
     {
       gsl_vector_free(_theta);
       _theta = NULL;
+      gsl_vector_free(_previous_theta);
+      _previous_theta = NULL;
     }
   }
   gsl_vector_free(_z);
   _z = NULL;
+  clear_memory();
 }
 
 /**
@@ -534,7 +648,7 @@ void Individual::write_theta( int generation )
 
 /**
  * \brief    Rotate the matrix m by angle theta on the plane (a, b)
- * \details  --
+ * \details  Only rows a and b change, so the rotation is applied in place
  * \param    int a
  * \param    int b
  * \param    double theta
@@ -542,21 +656,20 @@ void Individual::write_theta( int generation )
  */
 void Individual::rotate( gsl_matrix* m, int a, int b, double theta )
 {
-  gsl_matrix* newm = gsl_matrix_alloc(_n, _n);
-  gsl_matrix_memcpy(newm, m);
+  double cos_theta = cos(theta);
+  double sin_theta = sin(theta);
   for (int k = 0; k < _n; k++)
   {
-    gsl_matrix_set(newm, a, k, cos(theta)*gsl_matrix_get(m, a, k)-sin(theta)*gsl_matrix_get(m, b, k));
-    gsl_matrix_set(newm, b, k, sin(theta)*gsl_matrix_get(m, a, k)+cos(theta)*gsl_matrix_get(m, b, k));
+    double m_ak = gsl_matrix_get(m, a, k);
+    double m_bk = gsl_matrix_get(m, b, k);
+    gsl_matrix_set(m, a, k, cos_theta*m_ak-sin_theta*m_bk);
+    gsl_matrix_set(m, b, k, sin_theta*m_ak+cos_theta*m_bk);
   }
-  gsl_matrix_memcpy(m, newm);
-  gsl_matrix_free(newm);
-  newm = NULL;
 }
 
 /**
  * \brief    Build the co-variance matrix Sigma
- * \details  --
+ * \details  Sigma and the intermediate matrices live in the thread workspace
  * \param    void
  * \return   \e void
  */
@@ -565,7 +678,8 @@ void Individual::build_Sigma( void )
   /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
   /* 1) Create eigenvectors matrix         */
   /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
-  gsl_matrix* X = gsl_matrix_alloc(_n, _n);
+  workspace.resize(_n);
+  gsl_matrix* X = workspace.X;
   gsl_matrix_set_identity(X);
   
   /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
@@ -593,7 +707,7 @@ void Individual::build_Sigma( void )
   _max_Sigma_eigenvalue = 0.0;
   int    max_EV_index   = 0;
   double EV_sum         = 0.0;
-  gsl_matrix* D = gsl_matrix_alloc(_n, _n);
+  gsl_matrix* D = workspace.D;
   gsl_matrix_set_zero(D);
   for (int i = 0; i < _n; i++)
   {
@@ -611,7 +725,7 @@ void Individual::build_Sigma( void )
   /* 4) Save maximum eigenvector and       */
   /*    eigenvalue contribution            */
   /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
-  _max_Sigma_eigenvector  = gsl_vector_alloc(_n);
+  _max_Sigma_eigenvector  = workspace.eigenvector;
   _max_Sigma_contribution = _max_Sigma_eigenvalue/EV_sum;
   for (int i = 0; i < _n; i++)
   {
@@ -621,17 +735,11 @@ void Individual::build_Sigma( void )
   /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
   /* 5) Compute Sigma = X * D * X^-1       */
   /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
-  gsl_matrix* P = gsl_matrix_alloc(_n, _n);
-  _Sigma        = gsl_matrix_alloc(_n, _n);
+  gsl_matrix* P = workspace.P;
+  _Sigma        = workspace.Sigma;
   
   gsl_blas_dgemm(CblasNoTrans, CblasTrans, 1.0, D, X, 0.0, P);
   gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, X, P, 0.0, _Sigma);
-  gsl_matrix_free(X);
-  X = NULL;
-  gsl_matrix_free(D);
-  D = NULL;
-  gsl_matrix_free(P);
-  P = NULL;
 }
 
 /**
@@ -643,7 +751,7 @@ void Individual::build_Sigma( void )
 void Individual::compute_dot_product( void )
 {
   _max_dot_product = 0.0;
-  gsl_vector* d    = gsl_vector_alloc(_n);
+  gsl_vector* d    = workspace.d;
   gsl_vector_memcpy(d, _z_opt);
   gsl_vector_sub(d, _mu);
   double norm = gsl_blas_dnrm2(d);
@@ -652,8 +760,6 @@ void Individual::compute_dot_product( void )
     gsl_vector_set(d, i, gsl_vector_get(d, i)/norm);
   }
   gsl_blas_ddot(d, _max_Sigma_eigenvector, &_max_dot_product);
-  gsl_vector_free(d);
-  d = NULL;
   _max_dot_product = fabs(_max_dot_product);
 }
 
@@ -665,9 +771,6 @@ void Individual::compute_dot_product( void )
  */
 void Individual::Cholesky_decomposition( void )
 {
-  gsl_matrix_free(_Cholesky);
-  _Cholesky = NULL;
-  _Cholesky = gsl_matrix_alloc(_n, _n);
   gsl_matrix_memcpy(_Cholesky, _Sigma);
   gsl_linalg_cholesky_decomp(_Cholesky);
   /* L is in the lower triangle */
@@ -689,10 +792,8 @@ void Individual::draw_z( void )
   else
   {
     /* Draw the uniform vector N(0,1) */
-    for (int i = 0; i < _n; i++)
-    {
-      gsl_vector_set(_z, i, _prng->gaussian(0.0, 1.0));
-    }
+    assert(_z->stride == 1);
+    _prng->gaussian_block(_z->data, _n);
     
     /* Apply cholesky matrix */
     gsl_blas_dtrmv(CblasLower, CblasNoTrans, CblasNonUnit, _Cholesky, _z);
@@ -702,15 +803,36 @@ void Individual::draw_z( void )
 
 /**
  * \brief    Clear the memory
- * \details  --
+ * \details  Sigma and its maximum eigen vector belong to the thread workspace
+ *           and are only released from the individual
  * \param    void
  * \return   \e void
  */
 void Individual::clear_memory( void )
 {
-  gsl_matrix_free(_Sigma);
-  _Sigma = NULL;
-  gsl_vector_free(_max_Sigma_eigenvector);
+  _Sigma                 = NULL;
   _max_Sigma_eigenvector = NULL;
 }
 
+/**
+ * \brief    Allocate the buffers reused by mutate() and build_phenotype()
+ * \details  --
+ * \param    void
+ * \return   \e void
+ */
+void Individual::allocate_buffers( void )
+{
+  _previous_mu    = gsl_vector_alloc(_n);
+  _previous_sigma = NULL;
+  _previous_theta = NULL;
+  if (_noise_type != NONE)
+  {
+    _Cholesky       = gsl_matrix_alloc(_n, _n);
+    _previous_sigma = gsl_vector_alloc(_n);
+    if (_n > 1 && _noise_type == FULL)
+    {
+      _previous_theta = gsl_vector_alloc(_n*(_n-1)/2);
+    }
+  }
+}
+
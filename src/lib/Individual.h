@@ -72,6 +72,7 @@ public:
   
   inline unsigned long long int get_identifier( void ) const;
   inline int                    get_generation( void ) const;
+  inline unsigned int           get_node( void ) const;
   inline double                 get_mu( int i ) const;
   inline double                 get_sigma( int i ) const;
   inline double                 get_theta( int i ) const;
@@ -97,12 +98,16 @@ public:
    *----------------------------*/
   Individual& operator=(const Individual&) = delete;
   
+  inline void set_prng( Prng* prng );
   inline void set_identifier( unsigned long long int identifier );
   inline void set_generation( int generation );
+  inline void set_node( unsigned int node );
   
   /*----------------------------
    * PUBLIC METHODS
    *----------------------------*/
+  void copy( const Individual& individual );
+  bool has_same_genotype( const Individual& individual ) const;
   void mutate( double m_mu, double m_sigma, double m_theta, double s_mu, double s_sigma, double s_theta );
   void build_phenotype( void );
   void compute_fitness( double alpha, double beta, double Q );
@@ -127,6 +132,7 @@ protected:
   void Cholesky_decomposition( void );
   void draw_z( void );
   void clear_memory( void );
+  void allocate_buffers( void );
   
   /*----------------------------
    * PROTECTED ATTRIBUTES
@@ -143,6 +149,7 @@ protected:
   
   unsigned long long int _identifier; /*!< Individual's identifier       */
   int                    _generation; /*!< Individual's generation       */
+  unsigned int           _node;       /*!< Lineage tree node index       */
   gsl_vector*            _mu;         /*!< mu vector                     */
   gsl_vector*            _sigma;      /*!< sigma vector                  */
   gsl_vector*            _theta;      /*!< theta vector                  */
@@ -164,9 +171,12 @@ protected:
   
   /*----------------------------------------------- MUTATIONS */
   
-  double _r_mu;    /*!< Euclidean size of mu mutation    */
-  double _r_sigma; /*!< Euclidean size of sigma mutation */
-  double _r_theta; /*!< Euclidean size of theta mutation */
+  double      _r_mu;           /*!< Euclidean size of mu mutation    */
+  double      _r_sigma;        /*!< Euclidean size of sigma mutation */
+  double      _r_theta;        /*!< Euclidean size of theta mutation */
+  gsl_vector* _previous_mu;    /*!< mu vector before mutation        */
+  gsl_vector* _previous_sigma; /*!< sigma vector before mutation     */
+  gsl_vector* _previous_theta; /*!< theta vector before mutation     */
   
 };
 
@@ -199,6 +209,17 @@ inline int Individual::get_generation( void ) const
   return _generation;
 }
 
+/**
+ * \brief    Get the index of individual's node in the lineage tree
+ * \details  NO_NODE when lineages are not tracked
+ * \param    void
+ * \return   \e unsigned int
+ */
+inline unsigned int Individual::get_node( void ) const
+{
+  return _node;
+}
+
 /**
  * \brief    Get mu value at position i
  * \details  --
@@ -353,6 +374,19 @@ inline double Individual::get_r_theta( void ) const
  * SETTERS
  *----------------------------*/
 
+/*----------------------------------------------- PARAMETERS */
+
+/**
+ * \brief    Set the pseudorandom numbers generator
+ * \details  Used to give each offspring its own substream
+ * \param    Prng* prng
+ * \return   \e void
+ */
+inline void Individual::set_prng( Prng* prng )
+{
+  _prng = prng;
+}
+
 /*----------------------------------------------- VARIABLES */
 
 /**
@@ -378,5 +412,16 @@ inline void Individual::set_generation( int generation )
   _generation = generation;
 }
 
+/**
+ * \brief    Set the index of individual's node in the lineage tree
+ * \details  --
+ * \param    unsigned int node
+ * \return   \e void
+ */
+inline void Individual::set_node( unsigned int node )
+{
+  _node = node;
+}
+
 
 #endif /* defined(__SigmaFGM__Individual__) */
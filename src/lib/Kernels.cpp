@@ -0,0 +1,98 @@
+
+/**
+ * \file      Kernels.cpp
+ * \authors   Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * \date      18-10-2026
+ * \copyright Copyright (C) 2016-2020 Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard. All rights reserved
+ * \license   This project is released under the GNU General Public License
+ * \brief     Kernels class definition
+ */
+
+/***********************************************************************
+ * Copyright (C) 2016-2020
+ * Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * Web: https://github.com/charlesrocabert/SigmaFGM/
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#include "Kernels.h"
+
+void fill_kernel_table_baseline( kernel_table* table );
+#ifdef KERNELS_X86
+void fill_kernel_table_avx2( kernel_table* table );
+void fill_kernel_table_avx512( kernel_table* table );
+#endif
+
+kernel_table Kernels::_table = {NULL, NULL, NULL, NULL, NULL};
+#ifdef __SSE2__
+kernel_isa   Kernels::_isa   = SSE2;
+#else
+kernel_isa   Kernels::_isa   = GENERIC;
+#endif
+
+
+/*----------------------------
+ * GETTERS
+ *----------------------------*/
+
+/**
+ * \brief    Get the name of the selected instruction set
+ * \details  --
+ * \param    void
+ * \return   \e const char*
+ */
+const char* Kernels::get_isa_name( void )
+{
+  switch (_isa)
+  {
+    case GENERIC:
+      return "GENERIC";
+    case SSE2:
+      return "SSE2";
+    case AVX2:
+      return "AVX2";
+    case AVX512:
+      return "AVX512";
+  }
+  return "UNKNOWN";
+}
+
+/*----------------------------
+ * PUBLIC METHODS
+ *----------------------------*/
+
+/**
+ * \brief    Select the kernels of the widest instruction set supported by the CPU
+ * \details  Must be called once at startup, before any kernel is used
+ * \param    void
+ * \return   \e void
+ */
+void Kernels::select( void )
+{
+  fill_kernel_table_baseline(&_table);
+#ifdef KERNELS_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f"))
+  {
+    fill_kernel_table_avx512(&_table);
+    _isa = AVX512;
+  }
+  else if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+  {
+    fill_kernel_table_avx2(&_table);
+    _isa = AVX2;
+  }
+#endif
+}
@@ -0,0 +1,195 @@
+
+/**
+ * \file      Kernels.h
+ * \authors   Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * \date      18-10-2026
+ * \copyright Copyright (C) 2016-2020 Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard. All rights reserved
+ * \license   This project is released under the GNU General Public License
+ * \brief     Kernels class declaration
+ */
+
+/***********************************************************************
+ * Copyright (C) 2016-2020
+ * Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * Web: https://github.com/charlesrocabert/SigmaFGM/
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#ifndef __SigmaFGM__Kernels__
+#define __SigmaFGM__Kernels__
+
+#include <iostream>
+#include <assert.h>
+
+#include "Macros.h"
+#include "Enums.h"
+#include "Structs.h"
+
+
+class Kernels
+{
+  
+public:
+  
+  /*----------------------------
+   * CONSTRUCTORS
+   *----------------------------*/
+  Kernels( void ) = delete;
+  Kernels( const Kernels& kernels ) = delete;
+  
+  /*----------------------------
+   * DESTRUCTORS
+   *----------------------------*/
+  ~Kernels( void ) = delete;
+  
+  /*----------------------------
+   * GETTERS
+   *----------------------------*/
+  inline static kernel_isa get_isa( void );
+  static const char*       get_isa_name( void );
+  
+  /*----------------------------
+   * SETTERS
+   *----------------------------*/
+  Kernels& operator=(const Kernels&) = delete;
+  
+  /*----------------------------
+   * PUBLIC METHODS
+   *----------------------------*/
+  static void          select( void );
+  inline static void   phenotype( double* z, const double* mu, const double* sigma, const double* gaussian, int n );
+  inline static void   distance( double* d, const double* x, double x_opt, int n );
+  inline static void   fitness( double* W, const double* d, double alpha, double beta, double Q, int n );
+  inline static double sum( const double* x, int n );
+  inline static void   box_muller( double* gaussian, const double* uniform, int n );
+  
+  /*----------------------------
+   * PUBLIC ATTRIBUTES
+   *----------------------------*/
+  
+protected:
+  
+  /*----------------------------
+   * PROTECTED METHODS
+   *----------------------------*/
+  
+  /*----------------------------
+   * PROTECTED ATTRIBUTES
+   *----------------------------*/
+  static kernel_table _table; /*!< Kernels of the selected instruction set */
+  static kernel_isa   _isa;   /*!< Selected instruction set                */
+};
+
+
+/*----------------------------
+ * GETTERS
+ *----------------------------*/
+
+/**
+ * \brief    Get the selected instruction set
+ * \details  --
+ * \param    void
+ * \return   \e kernel_isa
+ */
+inline kernel_isa Kernels::get_isa( void )
+{
+  return _isa;
+}
+
+/*----------------------------
+ * SETTERS
+ *----------------------------*/
+
+/*----------------------------
+ * PUBLIC METHODS
+ *----------------------------*/
+
+/**
+ * \brief    Build the phenotypes z = mu+sigma*gaussian
+ * \details  --
+ * \param    double* z
+ * \param    const double* mu
+ * \param    const double* sigma
+ * \param    const double* gaussian
+ * \param    int n
+ * \return   \e void
+ */
+inline void Kernels::phenotype( double* z, const double* mu, const double* sigma, const double* gaussian, int n )
+{
+  assert(_table.phenotype != NULL);
+  _table.phenotype(z, mu, sigma, gaussian, n);
+}
+
+/**
+ * \brief    Compute the distances d = |x-x_opt|
+ * \details  --
+ * \param    double* d
+ * \param    const double* x
+ * \param    double x_opt
+ * \param    int n
+ * \return   \e void
+ */
+inline void Kernels::distance( double* d, const double* x, double x_opt, int n )
+{
+  assert(_table.distance != NULL);
+  _table.distance(d, x, x_opt, n);
+}
+
+/**
+ * \brief    Compute the fitnesses W = (1-beta)*exp(-alpha*d^Q)+beta
+ * \details  --
+ * \param    double* W
+ * \param    const double* d
+ * \param    double alpha
+ * \param    double beta
+ * \param    double Q
+ * \param    int n
+ * \return   \e void
+ */
+inline void Kernels::fitness( double* W, const double* d, double alpha, double beta, double Q, int n )
+{
+  assert(_table.fitness != NULL);
+  _table.fitness(W, d, alpha, beta, Q, n);
+}
+
+/**
+ * \brief    Sum the values of x
+ * \details  The summation order does not depend on the instruction set
+ * \param    const double* x
+ * \param    int n
+ * \return   \e double
+ */
+inline double Kernels::sum( const double* x, int n )
+{
+  assert(_table.sum != NULL);
+  return _table.sum(x, n);
+}
+
+/**
+ * \brief    Transform uniform draws in [0,1) into N(0,1) draws (Box-Muller)
+ * \details  uniform must hold n+(n%2) values
+ * \param    double* gaussian
+ * \param    const double* uniform
+ * \param    int n
+ * \return   \e void
+ */
+inline void Kernels::box_muller( double* gaussian, const double* uniform, int n )
+{
+  assert(_table.box_muller != NULL);
+  _table.box_muller(gaussian, uniform, n);
+}
+
+
+#endif /* defined(__SigmaFGM__Kernels__) */
@@ -0,0 +1,196 @@
+
+/**
+ * \file      KernelsImpl.h
+ * \authors   Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * \date      18-10-2026
+ * \copyright Copyright (C) 2016-2020 Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard. All rights reserved
+ * \license   This project is released under the GNU General Public License
+ * \brief     Numeric kernels implementation
+ */
+
+/***********************************************************************
+ * Copyright (C) 2016-2020
+ * Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * Web: https://github.com/charlesrocabert/SigmaFGM/
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+/*
+ * This file is included by each Kernels_<isa>.cpp translation unit, which
+ * is compiled with the flags of its instruction set. All the functions are
+ * static, and only C math functions are called, so that no inline function
+ * compiled for a wide instruction set can be picked by the linker for the
+ * rest of the program.
+ *
+ * The kernels are plain loops vectorized by the compiler. Floating point
+ * contraction is disabled (-ffp-contract=off) and reductions use a fixed
+ * number of accumulators, so all the variants return the same values.
+ */
+
+#ifndef KERNELS_FILL_TABLE
+#error "KERNELS_FILL_TABLE must be defined before including KernelsImpl.h"
+#endif
+
+#include <math.h>
+
+#include "Structs.h"
+
+#define KERNELS_ACCUMULATORS 8
+
+
+/**
+ * \brief    Build the phenotypes z = mu+sigma*gaussian
+ * \details  --
+ * \param    double* z
+ * \param    const double* mu
+ * \param    const double* sigma
+ * \param    const double* gaussian
+ * \param    int n
+ * \return   \e void
+ */
+static void kernel_phenotype( double* __restrict__ z, const double* __restrict__ mu, const double* __restrict__ sigma, const double* __restrict__ gaussian, int n )
+{
+  for (int i = 0; i < n; i++)
+  {
+    z[i] = mu[i]+sigma[i]*gaussian[i];
+  }
+}
+
+/**
+ * \brief    Compute the distances d = |x-x_opt|
+ * \details  --
+ * \param    double* d
+ * \param    const double* x
+ * \param    double x_opt
+ * \param    int n
+ * \return   \e void
+ */
+static void kernel_distance( double* __restrict__ d, const double* __restrict__ x, double x_opt, int n )
+{
+  for (int i = 0; i < n; i++)
+  {
+    d[i] = fabs(x[i]-x_opt);
+  }
+}
+
+/**
+ * \brief    Compute the fitnesses W = (1-beta)*exp(-alpha*d^Q)+beta
+ * \details  The common case Q = 2 avoids the call to pow(), which returns
+ *           the correctly rounded square as well
+ * \param    double* W
+ * \param    const double* d
+ * \param    double alpha
+ * \param    double beta
+ * \param    double Q
+ * \param    int n
+ * \return   \e void
+ */
+static void kernel_fitness( double* __restrict__ W, const double* __restrict__ d, double alpha, double beta, double Q, int n )
+{
+  if (Q == 2.0)
+  {
+    for (int i = 0; i < n; i++)
+    {
+      W[i] = -alpha*(d[i]*d[i]);
+    }
+  }
+  else
+  {
+    for (int i = 0; i < n; i++)
+    {
+      W[i] = -alpha*pow(d[i], Q);
+    }
+  }
+  for (int i = 0; i < n; i++)
+  {
+    W[i] = exp(W[i]);
+  }
+  for (int i = 0; i < n; i++)
+  {
+    W[i] = (1.0-beta)*W[i]+beta;
+  }
+}
+
+/**
+ * \brief    Sum the values of x
+ * \details  Value i is added to accumulator i%8, and the accumulators are
+ *           merged pairwise in a fixed order
+ * \param    const double* x
+ * \param    int n
+ * \return   \e double
+ */
+static double kernel_sum( const double* __restrict__ x, int n )
+{
+  double acc[KERNELS_ACCUMULATORS];
+  for (int j = 0; j < KERNELS_ACCUMULATORS; j++)
+  {
+    acc[j] = 0.0;
+  }
+  int i = 0;
+  for (; i+KERNELS_ACCUMULATORS <= n; i += KERNELS_ACCUMULATORS)
+  {
+    for (int j = 0; j < KERNELS_ACCUMULATORS; j++)
+    {
+      acc[j] += x[i+j];
+    }
+  }
+  for (int j = 0; i+j < n; j++)
+  {
+    acc[j] += x[i+j];
+  }
+  return ((acc[0]+acc[4])+(acc[1]+acc[5]))+((acc[2]+acc[6])+(acc[3]+acc[7]));
+}
+
+/**
+ * \brief    Transform uniform draws in [0,1) into N(0,1) draws (Box-Muller)
+ * \details  Each pair (u1, u2) gives the pair (r*cos(2*pi*u2), r*sin(2*pi*u2))
+ *           with r = sqrt(-2*log(1-u1)). uniform must hold n+(n%2) values
+ * \param    double* gaussian
+ * \param    const double* uniform
+ * \param    int n
+ * \return   \e void
+ */
+static void kernel_box_muller( double* __restrict__ gaussian, const double* __restrict__ uniform, int n )
+{
+  const double two_pi = 6.283185307179586476925286766559;
+  int          pairs  = n/2;
+  for (int j = 0; j < pairs; j++)
+  {
+    double r        = sqrt(-2.0*log(1.0-uniform[2*j]));
+    double theta    = two_pi*uniform[2*j+1];
+    gaussian[2*j]   = r*cos(theta);
+    gaussian[2*j+1] = r*sin(theta);
+  }
+  if (n%2 == 1)
+  {
+    double r      = sqrt(-2.0*log(1.0-uniform[n-1]));
+    gaussian[n-1] = r*cos(two_pi*uniform[n]);
+  }
+}
+
+/**
+ * \brief    Fill a kernels table with the kernels of this translation unit
+ * \details  --
+ * \param    kernel_table* table
+ * \return   \e void
+ */
+void KERNELS_FILL_TABLE( kernel_table* table )
+{
+  table->phenotype  = &kernel_phenotype;
+  table->distance   = &kernel_distance;
+  table->fitness    = &kernel_fitness;
+  table->sum        = &kernel_sum;
+  table->box_muller = &kernel_box_muller;
+}
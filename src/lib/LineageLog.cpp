@@ -0,0 +1,212 @@
+
+/**
+ * \file      LineageLog.cpp
+ * \authors   Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * \date      18-10-2026
+ * \copyright Copyright (C) 2016-2020 Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard. All rights reserved
+ * \license   This project is released under the GNU General Public License
+ * \brief     LineageLog class definition
+ */
+
+/***********************************************************************
+ * Copyright (C) 2016-2020
+ * Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * Web: https://github.com/charlesrocabert/SigmaFGM/
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#include "LineageLog.h"
+
+
+/*----------------------------
+ * CONSTRUCTORS
+ *----------------------------*/
+
+/**
+ * \brief    Constructor
+ * \details  The log only keeps the ancestors of the living individuals:
+ *           each entry points to its parent entry and counts its references
+ *           (its child entries, plus one while the individual is alive).
+ *           Entries are never modified once appended, and are reclaimed when
+ *           no living lineage references them. Unlike the lineage tree,
+ *           there are no children lists, so the genealogy cannot be walked
+ *           down
+ * \param    void
+ * \return   \e void
+ */
+LineageLog::LineageLog( void )
+{
+  _entries.clear();
+  _records.clear();
+  _free_entries.clear();
+  _number_of_entries = 0;
+}
+
+/*----------------------------
+ * DESTRUCTORS
+ *----------------------------*/
+
+/**
+ * \brief    Destructor
+ * \details  --
+ * \param    void
+ * \return   \e void
+ */
+LineageLog::~LineageLog( void )
+{
+  _entries.clear();
+  _records.clear();
+  _free_entries.clear();
+}
+
+/*----------------------------
+ * PUBLIC METHODS
+ *----------------------------*/
+
+/**
+ * \brief    Add a root to the log
+ * \details  The individual records its entry index
+ * \param    Individual* individual
+ * \return   \e void
+ */
+void LineageLog::add_root( Individual* individual )
+{
+  individual->set_node(new_entry(NO_NODE, individual));
+}
+
+/**
+ * \brief    Add a reproduction event
+ * \details  The child records its entry index, which references the entry
+ *           of the parent
+ * \param    Individual* parent
+ * \param    Individual* child
+ * \return   \e void
+ */
+void LineageLog::add_reproduction_event( Individual* parent, Individual* child )
+{
+  unsigned int parent_entry = parent->get_node();
+  assert(parent_entry < _entries.size());
+  assert(_entries[parent_entry].in_use);
+  _entries[parent_entry].references++;
+  child->set_node(new_entry(parent_entry, child));
+}
+
+/**
+ * \brief    Add a death event
+ * \details  The individual drops the reference to its entry. The cost is
+ *           proportional to the number of reclaimed entries
+ * \param    Individual* individual
+ * \return   \e void
+ */
+void LineageLog::add_death_event( Individual* individual )
+{
+  unsigned int entry = individual->get_node();
+  assert(entry < _entries.size());
+  assert(_entries[entry].in_use);
+  assert(_entries[entry].alive);
+  _entries[entry].alive = false;
+  individual->set_node(NO_NODE);
+  release_reference(entry);
+}
+
+/**
+ * \brief    Write best lineage statistics
+ * \details  Same format as Tree::write_best_lineage_statistics()
+ * \param    void
+ * \return   \e void
+ */
+void LineageLog::write_best_lineage_statistics( void )
+{
+  double       best_w     = 0.0;
+  unsigned int best_entry = NO_NODE;
+  for (unsigned int i = 0; i < _entries.size(); i++)
+  {
+    if (_entries[i].in_use && _entries[i].alive && best_w < _records[i].Wz)
+    {
+      best_w     = _records[i].Wz;
+      best_entry = i;
+    }
+  }
+  std::ofstream file("best_lineage.txt", std::ios::out | std::ios::trunc);
+  Tree::write_lineage_header(file);
+  for (unsigned int entry = best_entry; entry != NO_NODE; entry = _entries[entry].parent)
+  {
+    Tree::write_lineage_record(file, _records[entry]);
+  }
+  file.close();
+}
+
+/*----------------------------
+ * PROTECTED METHODS
+ *----------------------------*/
+
+/**
+ * \brief    Append a new entry
+ * \details  Recycles a reclaimed slot if any, else grows the arena. The entry
+ *           is alive, with the reference of its individual
+ * \param    unsigned int parent
+ * \param    Individual* individual
+ * \return   \e unsigned int
+ */
+unsigned int LineageLog::new_entry( unsigned int parent, Individual* individual )
+{
+  unsigned int entry = 0;
+  if (!_free_entries.empty())
+  {
+    entry = _free_entries.back();
+    _free_entries.pop_back();
+  }
+  else
+  {
+    assert(_entries.size() < (size_t)NO_NODE);
+    entry = (unsigned int)_entries.size();
+    _entries.push_back(lineage_log_entry());
+    _records.push_back(lineage_record());
+  }
+  lineage_log_entry& slot = _entries[entry];
+  slot.parent             = parent;
+  slot.references         = 1;
+  slot.alive              = true;
+  slot.in_use             = true;
+  Tree::record_individual(_records[entry], individual);
+  _number_of_entries++;
+  return entry;
+}
+
+/**
+ * \brief    Release a reference to an entry
+ * \details  An entry without references is reclaimed, and releases its
+ *           reference to its parent, up to the first entry still referenced
+ * \param    unsigned int entry
+ * \return   \e void
+ */
+void LineageLog::release_reference( unsigned int entry )
+{
+  while (entry != NO_NODE)
+  {
+    assert(_entries[entry].in_use);
+    assert(_entries[entry].references > 0);
+    _entries[entry].references--;
+    if (_entries[entry].references > 0)
+    {
+      return;
+    }
+    unsigned int parent    = _entries[entry].parent;
+    _entries[entry].in_use = false;
+    _free_entries.push_back(entry);
+    _number_of_entries--;
+    entry = parent;
+  }
+}
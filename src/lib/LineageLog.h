@@ -0,0 +1,147 @@
+
+/**
+ * \file      LineageLog.h
+ * \authors   Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * \date      18-10-2026
+ * \copyright Copyright (C) 2016-2020 Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard. All rights reserved
+ * \license   This project is released under the GNU General Public License
+ * \brief     LineageLog class declaration
+ */
+
+/***********************************************************************
+ * Copyright (C) 2016-2020
+ * Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * Web: https://github.com/charlesrocabert/SigmaFGM/
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#ifndef __SigmaFGM__LineageLog__
+#define __SigmaFGM__LineageLog__
+
+#include <iostream>
+#include <vector>
+#include <cstring>
+#include <fstream>
+#include <assert.h>
+
+#include "Macros.h"
+#include "Enums.h"
+#include "Structs.h"
+#include "Individual.h"
+#include "Tree.h"
+
+
+class LineageLog
+{
+  
+public:
+  
+  /*----------------------------
+   * CONSTRUCTORS
+   *----------------------------*/
+  LineageLog( void );
+  LineageLog( const LineageLog& lineage_log ) = delete;
+  
+  /*----------------------------
+   * DESTRUCTORS
+   *----------------------------*/
+  ~LineageLog( void );
+  
+  /*----------------------------
+   * GETTERS
+   *----------------------------*/
+  inline int                   get_number_of_entries( void ) const;
+  inline unsigned int          get_arena_size( void ) const;
+  inline const lineage_record* get_record( unsigned int entry ) const;
+  
+  /*----------------------------
+   * SETTERS
+   *----------------------------*/
+  LineageLog& operator=(const LineageLog&) = delete;
+  
+  /*----------------------------
+   * PUBLIC METHODS
+   *----------------------------*/
+  void add_root( Individual* individual );
+  void add_reproduction_event( Individual* parent, Individual* child );
+  void add_death_event( Individual* individual );
+  void write_best_lineage_statistics( void );
+  
+  /*----------------------------
+   * PUBLIC ATTRIBUTES
+   *----------------------------*/
+  
+protected:
+  
+  /*----------------------------
+   * PROTECTED METHODS
+   *----------------------------*/
+  unsigned int new_entry( unsigned int parent, Individual* individual );
+  void         release_reference( unsigned int entry );
+  
+  /*----------------------------
+   * PROTECTED ATTRIBUTES
+   *----------------------------*/
+  std::vector<lineage_log_entry> _entries;           /*!< Entry arena                       */
+  std::vector<lineage_record>    _records;           /*!< Record of each entry (same slots) */
+  std::vector<unsigned int>      _free_entries;      /*!< Reclaimed slots, recycled first   */
+  int                            _number_of_entries; /*!< Number of slots in use            */
+};
+
+
+/*----------------------------
+ * GETTERS
+ *----------------------------*/
+
+/**
+ * \brief    Get the number of entries of the log
+ * \details  --
+ * \param    void
+ * \return   \e int
+ */
+inline int LineageLog::get_number_of_entries( void ) const
+{
+  return _number_of_entries;
+}
+
+/**
+ * \brief    Get the size of the entry arena
+ * \details  Slots from 0 to the arena size, in use or reclaimed
+ * \param    void
+ * \return   \e unsigned int
+ */
+inline unsigned int LineageLog::get_arena_size( void ) const
+{
+  return (unsigned int)_entries.size();
+}
+
+/**
+ * \brief    Get the record of an entry
+ * \details  The pointer is invalidated when entries are added
+ * \param    unsigned int entry
+ * \return   \e const lineage_record*
+ */
+inline const lineage_record* LineageLog::get_record( unsigned int entry ) const
+{
+  assert(entry < _records.size());
+  return &_records[entry];
+}
+
+/*----------------------------
+ * SETTERS
+ *----------------------------*/
+
+
+#endif /* defined(__SigmaFGM__LineageLog__) */
@@ -30,5 +30,20 @@
 #ifndef __SigmaFGM__Macros__
 #define __SigmaFGM__Macros__
 
+#define NUMBER_OF_STATISTICS 10          /*!< Number of variables in the statistic enum */
+#define NO_NODE              0xFFFFFFFFu /*!< Null node index of the lineage tree        */
+#define GENEALOGY_VERSION    1           /*!< Version of the genealogy tables format     */
+#define GENEALOGY_SAMPLE     0x1u        /*!< Node flag: alive in the final population   */
+#define FOCAL_SAMPLE_GROWTH  2           /*!< Focal sample growth before it is thinned   */
+#define CLADE_DIRECT_SUM     256         /*!< Clades summed without the prefix sums      */
+#define MONOMORPHIC_DRAWS    1000        /*!< Phenotype draws of a skipped generation    */
+#define MUTATION_LOG_VERSION 1           /*!< Version of the mutation log format         */
+#define MUTATION_MU          0x1u        /*!< Mutated component: mu                      */
+#define MUTATION_SIGMA       0x2u        /*!< Mutated component: sigma                   */
+#define MUTATION_THETA       0x4u        /*!< Mutated component: theta                   */
+#define MUTATION_FIXED       0x1u        /*!< Mutation fate: fixed                       */
+#define MUTATION_LOST        0x2u        /*!< Mutation fate: lost                        */
+#define MUTATION_EFFECT_MAX  20          /*!< Largest binned scaled effect |N*s|         */
+
 
 #endif /* defined(__SigmaFGM__Macros__) */
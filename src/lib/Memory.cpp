@@ -0,0 +1,115 @@
+
+/**
+ * \file      Memory.cpp
+ * \authors   Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * \date      18-10-2026
+ * \copyright Copyright (C) 2016-2020 Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard. All rights reserved
+ * \license   This project is released under the GNU General Public License
+ * \brief     Memory class definition
+ */
+
+/***********************************************************************
+ * Copyright (C) 2016-2020
+ * Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * Web: https://github.com/charlesrocabert/SigmaFGM/
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#include "Memory.h"
+
+bool Memory::_hugepages = false;
+
+
+/*----------------------------
+ * PUBLIC METHODS
+ *----------------------------*/
+
+/**
+ * \brief    Allocate a buffer of n doubles
+ * \details  Buffers are aligned on a cache line. With huge pages, buffers of
+ *           at least MEMORY_HUGEPAGE_SIZE bytes are mapped directly and
+ *           advised as huge pages. Pages are not touched: they are placed on
+ *           the NUMA node of the thread writing them first
+ * \param    size_t n
+ * \return   \e double*
+ */
+double* Memory::allocate_doubles( size_t n )
+{
+  assert(n > 0);
+  size_t bytes  = n*sizeof(double);
+  void*  buffer = NULL;
+#ifdef __linux__
+  if (is_huge(bytes))
+  {
+    size_t mapped = (bytes+MEMORY_HUGEPAGE_SIZE-1)/MEMORY_HUGEPAGE_SIZE*MEMORY_HUGEPAGE_SIZE;
+    buffer        = mmap(NULL, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (buffer == MAP_FAILED)
+    {
+      std::cout << "Error: huge pages buffer allocation failed.\n";
+      exit(EXIT_FAILURE);
+    }
+#ifdef MADV_HUGEPAGE
+    madvise(buffer, mapped, MADV_HUGEPAGE);
+#endif
+    return (double*)buffer;
+  }
+#endif
+  if (posix_memalign(&buffer, MEMORY_ALIGNMENT, bytes) != 0)
+  {
+    std::cout << "Error: buffer allocation failed.\n";
+    exit(EXIT_FAILURE);
+  }
+  return (double*)buffer;
+}
+
+/**
+ * \brief    Release a buffer of n doubles allocated by allocate_doubles()
+ * \details  --
+ * \param    double* buffer
+ * \param    size_t n
+ * \return   \e void
+ */
+void Memory::release_doubles( double* buffer, size_t n )
+{
+  if (buffer == NULL)
+  {
+    return;
+  }
+  size_t bytes = n*sizeof(double);
+#ifdef __linux__
+  if (is_huge(bytes))
+  {
+    size_t mapped = (bytes+MEMORY_HUGEPAGE_SIZE-1)/MEMORY_HUGEPAGE_SIZE*MEMORY_HUGEPAGE_SIZE;
+    munmap(buffer, mapped);
+    return;
+  }
+#endif
+  free(buffer);
+}
+
+/*----------------------------
+ * PROTECTED METHODS
+ *----------------------------*/
+
+/**
+ * \brief    Indicates if a buffer of this size is backed by huge pages
+ * \details  --
+ * \param    size_t bytes
+ * \return   \e bool
+ */
+bool Memory::is_huge( size_t bytes )
+{
+  return (_hugepages && bytes >= MEMORY_HUGEPAGE_SIZE);
+}
@@ -0,0 +1,131 @@
+
+/**
+ * \file      Memory.h
+ * \authors   Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * \date      18-10-2026
+ * \copyright Copyright (C) 2016-2020 Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard. All rights reserved
+ * \license   This project is released under the GNU General Public License
+ * \brief     Memory class declaration
+ */
+
+/***********************************************************************
+ * Copyright (C) 2016-2020
+ * Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * Web: https://github.com/charlesrocabert/SigmaFGM/
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#ifndef __SigmaFGM__Memory__
+#define __SigmaFGM__Memory__
+
+#include <iostream>
+#include <cstdlib>
+#include <assert.h>
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#include "Macros.h"
+
+/* Size of a huge page, and smallest buffer backed by huge pages */
+#define MEMORY_HUGEPAGE_SIZE 2097152
+/* Alignment of the other buffers (one cache line) */
+#define MEMORY_ALIGNMENT 64
+
+
+class Memory
+{
+  
+public:
+  
+  /*----------------------------
+   * CONSTRUCTORS
+   *----------------------------*/
+  Memory( void ) = delete;
+  Memory( const Memory& memory ) = delete;
+  
+  /*----------------------------
+   * DESTRUCTORS
+   *----------------------------*/
+  ~Memory( void ) = delete;
+  
+  /*----------------------------
+   * GETTERS
+   *----------------------------*/
+  static inline bool get_hugepages( void );
+  
+  /*----------------------------
+   * SETTERS
+   *----------------------------*/
+  Memory& operator=(const Memory&) = delete;
+  
+  static inline void set_hugepages( bool hugepages );
+  
+  /*----------------------------
+   * PUBLIC METHODS
+   *----------------------------*/
+  static double* allocate_doubles( size_t n );
+  static void    release_doubles( double* buffer, size_t n );
+  
+  /*----------------------------
+   * PUBLIC ATTRIBUTES
+   *----------------------------*/
+  
+protected:
+  
+  /*----------------------------
+   * PROTECTED METHODS
+   *----------------------------*/
+  static bool is_huge( size_t bytes );
+  
+  /*----------------------------
+   * PROTECTED ATTRIBUTES
+   *----------------------------*/
+  static bool _hugepages; /*!< Indicates if large buffers are backed by huge pages */
+};
+
+
+/*----------------------------
+ * GETTERS
+ *----------------------------*/
+
+/**
+ * \brief    Indicates if large buffers are backed by huge pages
+ * \details  --
+ * \param    void
+ * \return   \e bool
+ */
+inline bool Memory::get_hugepages( void )
+{
+  return _hugepages;
+}
+
+/*----------------------------
+ * SETTERS
+ *----------------------------*/
+
+/**
+ * \brief    Back large buffers by huge pages
+ * \details  Must be set before any buffer is allocated
+ * \param    bool hugepages
+ * \return   \e void
+ */
+inline void Memory::set_hugepages( bool hugepages )
+{
+  _hugepages = hugepages;
+}
+
+
+#endif /* defined(__SigmaFGM__Memory__) */
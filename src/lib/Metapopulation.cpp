@@ -0,0 +1,236 @@
+
+/**
+ * \file      Metapopulation.cpp
+ * \authors   Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * \date      18-10-2026
+ * \copyright Copyright (C) 2016-2020 Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard. All rights reserved
+ * \license   This project is released under the GNU General Public License
+ * \brief     Metapopulation class definition
+ */
+
+/***********************************************************************
+ * Copyright (C) 2016-2020
+ * Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * Web: https://github.com/charlesrocabert/SigmaFGM/
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#include "Metapopulation.h"
+
+
+/*----------------------------
+ * CONSTRUCTORS
+ *----------------------------*/
+
+/**
+ * \brief    Constructor
+ * \details  The population is split into demes of (almost) equal sizes. Deme
+ *           d draws from its own prng, seeded from the simulation seed and d
+ *           (or positioned at the keyed stream of deme d with PHILOX), so the
+ *           results do not depend on the number of threads
+ * \param    Parameters* parameters
+ * \param    Environment* environment
+ * \param    Tree* tree
+ * \param    ThreadPool* thread_pool
+ * \return   \e void
+ */
+Metapopulation::Metapopulation( Parameters* parameters, Environment* environment, Tree* tree, ThreadPool* thread_pool )
+{
+  assert(parameters != NULL);
+  assert(parameters->get_number_of_demes() <= parameters->get_population_size());
+  
+  /*----------------------------------------------- PARAMETERS */
+  
+  _parameters  = parameters;
+  _prng        = _parameters->get_prng();
+  _thread_pool = thread_pool;
+  
+  /*----------------------------------------------- DEMES */
+  
+  int N            = _parameters->get_population_size();
+  _number_of_demes = _parameters->get_number_of_demes();
+  _deme_prngs      = new Prng*[_number_of_demes];
+  _demes           = new Population*[_number_of_demes];
+  auto create = [&]( int d )
+  {
+    int deme_size  = (int)((long long int)(d+1)*N/_number_of_demes-(long long int)d*N/_number_of_demes);
+    _deme_prngs[d] = new Prng(_parameters->get_prng_type());
+    if (_parameters->get_prng_type() == PHILOX)
+    {
+      _deme_prngs[d]->set_stream(_parameters->get_seed(), (unsigned int)d, 0, 0, DEME_STREAM);
+    }
+    else
+    {
+      _deme_prngs[d]->set_seed(Prng::substream_seed(_parameters->get_seed(), (unsigned long int)d));
+    }
+    _demes[d]      = new Population(_parameters, environment, tree, NULL, NULL, _deme_prngs[d], deme_size);
+  };
+  if (_thread_pool != NULL)
+  {
+    /*** Each deme is created by the thread computing it (first touch) ***/
+    _thread_pool->run_sharded(_number_of_demes, create);
+  }
+  else
+  {
+    for (int d = 0; d < _number_of_demes; d++)
+    {
+      create(d);
+    }
+  }
+  
+  /*----------------------------------------------- MIGRATIONS */
+  
+  _migrant_demes = new int[N];
+  _migrant_slots = new int[N];
+  _migrants      = new Individual*[N];
+  _slots         = new int[N];
+}
+
+/*----------------------------
+ * DESTRUCTORS
+ *----------------------------*/
+
+/**
+ * \brief    Destructor
+ * \details  --
+ * \param    void
+ * \return   \e void
+ */
+Metapopulation::~Metapopulation( void )
+{
+  for (int d = 0; d < _number_of_demes; d++)
+  {
+    delete _demes[d];
+    _demes[d] = NULL;
+    delete _deme_prngs[d];
+    _deme_prngs[d] = NULL;
+  }
+  delete[] _demes;
+  _demes = NULL;
+  delete[] _deme_prngs;
+  _deme_prngs = NULL;
+  delete[] _migrant_demes;
+  _migrant_demes = NULL;
+  delete[] _migrant_slots;
+  _migrant_slots = NULL;
+  delete[] _migrants;
+  _migrants = NULL;
+  delete[] _slots;
+  _slots = NULL;
+  _thread_pool = NULL;
+  _prng        = NULL;
+  _parameters  = NULL;
+}
+
+/*----------------------------
+ * PUBLIC METHODS
+ *----------------------------*/
+
+/**
+ * \brief    Compute the next generation
+ * \details  Demes are independent between two migrations, and are computed
+ *           on the thread pool when there is one (each deme always on the
+ *           thread that created it)
+ * \param    int next_generation
+ * \return   \e void
+ */
+void Metapopulation::compute_next_generation( int next_generation )
+{
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 1) Compute each deme                  */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  if (_thread_pool != NULL)
+  {
+    _thread_pool->run_sharded(_number_of_demes, [&]( int d )
+    {
+      _demes[d]->compute_next_generation(next_generation);
+    });
+  }
+  else
+  {
+    for (int d = 0; d < _number_of_demes; d++)
+    {
+      _demes[d]->compute_next_generation(next_generation);
+    }
+  }
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 2) Migrate                            */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  if (_parameters->get_migration_rate() > 0.0 && next_generation%_parameters->get_migration_interval() == 0)
+  {
+    migrate();
+  }
+}
+
+/*----------------------------
+ * PROTECTED METHODS
+ *----------------------------*/
+
+/**
+ * \brief    Migrate individuals between demes
+ * \details  Island model: each individual joins the migrants pool with the
+ *           migration probability, then the pool is shuffled and migrants
+ *           fill the positions left in the demes (a migrant may go back to
+ *           its own deme). Deme sizes do not change
+ * \param    void
+ * \return   \e void
+ */
+void Metapopulation::migrate( void )
+{
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 1) Draw the migrants of each deme     */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  int nb_migrants = 0;
+  for (int d = 0; d < _number_of_demes; d++)
+  {
+    int deme_size = _demes[d]->get_population_size();
+    int m         = (int)_prng->binomial((size_t)deme_size, _parameters->get_migration_rate());
+    for (int i = 0; i < deme_size; i++)
+    {
+      _slots[i] = i;
+    }
+    for (int j = 0; j < m; j++)
+    {
+      int k                       = _prng->uniform(j, deme_size-1);
+      int tmp                     = _slots[j];
+      _slots[j]                   = _slots[k];
+      _slots[k]                   = tmp;
+      _migrant_demes[nb_migrants] = d;
+      _migrant_slots[nb_migrants] = _slots[j];
+      _migrants[nb_migrants]      = _demes[d]->get_individual(_slots[j]);
+      nb_migrants++;
+    }
+  }
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 2) Shuffle the migrants pool          */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  for (int j = nb_migrants-1; j > 0; j--)
+  {
+    int         k   = _prng->uniform(0, j);
+    Individual* tmp = _migrants[j];
+    _migrants[j]    = _migrants[k];
+    _migrants[k]    = tmp;
+  }
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 3) Place the migrants                 */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  for (int j = 0; j < nb_migrants; j++)
+  {
+    _demes[_migrant_demes[j]]->set_individual(_migrant_slots[j], _migrants[j]);
+  }
+}
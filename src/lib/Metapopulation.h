@@ -0,0 +1,149 @@
+
+/**
+ * \file      Metapopulation.h
+ * \authors   Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * \date      18-10-2026
+ * \copyright Copyright (C) 2016-2020 Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard. All rights reserved
+ * \license   This project is released under the GNU General Public License
+ * \brief     Metapopulation class declaration
+ */
+
+/***********************************************************************
+ * Copyright (C) 2016-2020
+ * Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * Web: https://github.com/charlesrocabert/SigmaFGM/
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#ifndef __SigmaFGM__Metapopulation__
+#define __SigmaFGM__Metapopulation__
+
+#include <iostream>
+#include <assert.h>
+
+#include "Macros.h"
+#include "Enums.h"
+#include "Prng.h"
+#include "Parameters.h"
+#include "Environment.h"
+#include "Tree.h"
+#include "Individual.h"
+#include "Population.h"
+#include "ThreadPool.h"
+
+
+class Metapopulation
+{
+  
+public:
+  
+  /*----------------------------
+   * CONSTRUCTORS
+   *----------------------------*/
+  Metapopulation( void ) = delete;
+  Metapopulation( Parameters* parameters, Environment* environment, Tree* tree, ThreadPool* thread_pool );
+  Metapopulation( const Metapopulation& metapopulation ) = delete;
+  
+  /*----------------------------
+   * DESTRUCTORS
+   *----------------------------*/
+  ~Metapopulation( void );
+  
+  /*----------------------------
+   * GETTERS
+   *----------------------------*/
+  inline int         get_number_of_demes( void ) const;
+  inline Population* get_deme( int d );
+  
+  /*----------------------------
+   * SETTERS
+   *----------------------------*/
+  Metapopulation& operator=(const Metapopulation&) = delete;
+  
+  /*----------------------------
+   * PUBLIC METHODS
+   *----------------------------*/
+  void compute_next_generation( int next_generation );
+  
+  /*----------------------------
+   * PUBLIC ATTRIBUTES
+   *----------------------------*/
+  
+protected:
+  
+  /*----------------------------
+   * PROTECTED METHODS
+   *----------------------------*/
+  void migrate( void );
+  
+  /*----------------------------
+   * PROTECTED ATTRIBUTES
+   *----------------------------*/
+  
+  /*----------------------------------------------- PARAMETERS */
+  
+  Parameters* _parameters;  /*!< Parameters                                      */
+  Prng*       _prng;        /*!< Pseudorandom numbers generator (migrations)     */
+  ThreadPool* _thread_pool; /*!< Thread pool (NULL to compute demes sequentially) */
+  
+  /*----------------------------------------------- DEMES */
+  
+  int          _number_of_demes; /*!< Number of demes          */
+  Prng**       _deme_prngs;      /*!< Prng stream of each deme */
+  Population** _demes;           /*!< Demes                    */
+  
+  /*----------------------------------------------- MIGRATIONS */
+  
+  int*         _migrant_demes; /*!< Deme of each migrant                   */
+  int*         _migrant_slots; /*!< Position of each migrant in its deme   */
+  Individual** _migrants;      /*!< Migrants pool                          */
+  int*         _slots;         /*!< Positions of a deme (partial shuffles) */
+};
+
+
+/*----------------------------
+ * GETTERS
+ *----------------------------*/
+
+/**
+ * \brief    Get the number of demes
+ * \details  --
+ * \param    void
+ * \return   \e int
+ */
+inline int Metapopulation::get_number_of_demes( void ) const
+{
+  return _number_of_demes;
+}
+
+/**
+ * \brief    Get deme d
+ * \details  --
+ * \param    int d
+ * \return   \e Population*
+ */
+inline Population* Metapopulation::get_deme( int d )
+{
+  assert(d >= 0);
+  assert(d < _number_of_demes);
+  return _demes[d];
+}
+
+/*----------------------------
+ * SETTERS
+ *----------------------------*/
+
+
+#endif /* defined(__SigmaFGM__Metapopulation__) */
@@ -0,0 +1,301 @@
+
+/**
+ * \file      MutationLog.cpp
+ * \authors   Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * \date      18-10-2026
+ * \copyright Copyright (C) 2016-2020 Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard. All rights reserved
+ * \license   This project is released under the GNU General Public License
+ * \brief     MutationLog class definition
+ */
+
+/***********************************************************************
+ * Copyright (C) 2016-2020
+ * Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * Web: https://github.com/charlesrocabert/SigmaFGM/
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#include "MutationLog.h"
+
+
+/*----------------------------
+ * CONSTRUCTORS
+ *----------------------------*/
+
+/**
+ * \brief    Constructor
+ * \details  Opens both tables and writes their headers (same layout as the
+ *           genealogy tables). Rows are appended in host byte order: an event
+ *           row is 88 bytes (identifiers, birth generation, mutated
+ *           components, mutation sizes and fitnesses before and after), a
+ *           fate row is 16 bytes (event identifier, generation and fate)
+ * \param    std::string events_filename
+ * \param    std::string fates_filename
+ * \param    int population_size
+ * \return   \e void
+ */
+MutationLog::MutationLog( std::string events_filename, std::string fates_filename, int population_size )
+{
+  assert(population_size > 0);
+  _population_size  = population_size;
+  _generation       = 0;
+  _number_of_events = 0;
+  _first_counted    = 1;
+  _segregating.clear();
+  _bins.assign(2*MUTATION_EFFECT_MAX+1, fixation_statistics());
+  open_table(_events_file, events_filename, "SFGMMUTE", (uint32_t)sizeof(mutation_event));
+  open_table(_fates_file, fates_filename, "SFGMFATE", (uint32_t)sizeof(mutation_fate));
+}
+
+/*----------------------------
+ * DESTRUCTORS
+ *----------------------------*/
+
+/**
+ * \brief    Destructor
+ * \details  --
+ * \param    void
+ * \return   \e void
+ */
+MutationLog::~MutationLog( void )
+{
+  close();
+  _segregating.clear();
+  _bins.clear();
+}
+
+/*----------------------------
+ * PUBLIC METHODS
+ *----------------------------*/
+
+/**
+ * \brief    Append a mutation event
+ * \details  Returns the identifier of the event. Its effect size is
+ *           s = W(mu) after / W(mu) before - 1 for mu mutations (0 for
+ *           sigma or theta mutations alone), binned by unit of the scaled
+ *           effect N*s, from -MUTATION_EFFECT_MAX to MUTATION_EFFECT_MAX
+ *           (both ends include the tails)
+ * \param    const lineage_record& parent
+ * \param    const lineage_record& mutant
+ * \return   \e unsigned long long int
+ */
+unsigned long long int MutationLog::add_event( const lineage_record& parent, const lineage_record& mutant )
+{
+  assert(_events_file.is_open());
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 1) Write the event row                */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  mutation_event row;
+  row.identifier = (uint64_t)(++_number_of_events);
+  row.individual = (uint64_t)mutant.identifier;
+  row.parent     = (uint64_t)parent.identifier;
+  row.generation = (int32_t)mutant.generation;
+  row.components = (mutant.r_mu > 0.0 ? MUTATION_MU : 0)|(mutant.r_sigma > 0.0 ? MUTATION_SIGMA : 0)|(mutant.r_theta > 0.0 ? MUTATION_THETA : 0);
+  row.r_mu       = mutant.r_mu;
+  row.r_sigma    = mutant.r_sigma;
+  row.r_theta    = mutant.r_theta;
+  row.Wmu_before = parent.Wmu;
+  row.Wmu_after  = mutant.Wmu;
+  row.Wz_before  = parent.Wz;
+  row.Wz_after   = mutant.Wz;
+  _events_file.write((const char*)&row, sizeof(mutation_event));
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 2) Bin the effect size                */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  double s = 0.0;
+  if (mutant.r_mu > 0.0 && parent.Wmu > 0.0)
+  {
+    s = mutant.Wmu/parent.Wmu-1.0;
+  }
+  double scaled = floor((double)_population_size*s);
+  scaled        = (scaled < -MUTATION_EFFECT_MAX ? -MUTATION_EFFECT_MAX : scaled);
+  scaled        = (scaled > MUTATION_EFFECT_MAX ? MUTATION_EFFECT_MAX : scaled);
+  mutation_origin origin;
+  origin.generation = mutant.generation;
+  origin.bin        = (int)scaled+MUTATION_EFFECT_MAX;
+  _segregating[_number_of_events] = origin;
+  _bins[origin.bin].events++;
+  return _number_of_events;
+}
+
+/**
+ * \brief    Record the fixation of an event
+ * \details  --
+ * \param    unsigned long long int event
+ * \return   \e void
+ */
+void MutationLog::add_fixation( unsigned long long int event )
+{
+  add_fate(event, MUTATION_FIXED);
+}
+
+/**
+ * \brief    Record the loss of an event
+ * \details  --
+ * \param    unsigned long long int event
+ * \return   \e void
+ */
+void MutationLog::add_loss( unsigned long long int event )
+{
+  add_fate(event, MUTATION_LOST);
+}
+
+/**
+ * \brief    Reset the fixation statistics
+ * \details  Only the events appended from now on are counted. Events stay
+ *           in the tables, and their fates are still written
+ * \param    void
+ * \return   \e void
+ */
+void MutationLog::reset_statistics( void )
+{
+  _first_counted = _number_of_events+1;
+  for (size_t i = 0; i < _bins.size(); i++)
+  {
+    _bins[i].events        = 0;
+    _bins[i].fixed         = 0;
+    _bins[i].lost          = 0;
+    _bins[i].fixation_time = 0.0;
+  }
+}
+
+/**
+ * \brief    Write the fixation statistics by effect size
+ * \details  One line per bin of the scaled effect N*s, with its bounds in s.
+ *           The fixation probability is computed over the events whose fate
+ *           is known (-1 if none), the fixation time over the fixed events
+ *           (-1 if none)
+ * \param    void
+ * \return   \e void
+ */
+void MutationLog::write_fixation_statistics( void )
+{
+  std::ofstream file("mutation_fixation.txt", std::ios::out | std::ios::trunc);
+  file << "s_min s_max events fixed lost segregating p_fix t_fix\n";
+  for (int i = 0; i < (int)_bins.size(); i++)
+  {
+    const fixation_statistics& bin = _bins[i];
+    double s_min    = (double)(i-MUTATION_EFFECT_MAX)/(double)_population_size;
+    double s_max    = (double)(i-MUTATION_EFFECT_MAX+1)/(double)_population_size;
+    double resolved = (double)(bin.fixed+bin.lost);
+    if (i == 0)
+    {
+      s_min = -HUGE_VAL;
+    }
+    if (i == (int)_bins.size()-1)
+    {
+      s_max = HUGE_VAL;
+    }
+    file << s_min << " " << s_max << " ";
+    file << bin.events << " " << bin.fixed << " " << bin.lost << " " << bin.events-bin.fixed-bin.lost << " ";
+    file << (resolved > 0.0 ? (double)bin.fixed/resolved : -1.0) << " ";
+    file << (bin.fixed > 0 ? bin.fixation_time/(double)bin.fixed : -1.0) << "\n";
+  }
+  file.close();
+}
+
+/**
+ * \brief    Flush both tables
+ * \details  --
+ * \param    void
+ * \return   \e void
+ */
+void MutationLog::flush( void )
+{
+  _events_file.flush();
+  _fates_file.flush();
+}
+
+/**
+ * \brief    Close both tables
+ * \details  --
+ * \param    void
+ * \return   \e void
+ */
+void MutationLog::close( void )
+{
+  if (_events_file.is_open())
+  {
+    _events_file.close();
+  }
+  if (_fates_file.is_open())
+  {
+    _fates_file.close();
+  }
+}
+
+/*----------------------------
+ * PROTECTED METHODS
+ *----------------------------*/
+
+/**
+ * \brief    Open a table and write its header
+ * \details  --
+ * \param    std::ofstream& file
+ * \param    std::string filename
+ * \param    const char* magic
+ * \param    uint32_t row_size
+ * \return   \e void
+ */
+void MutationLog::open_table( std::ofstream& file, std::string filename, const char* magic, uint32_t row_size )
+{
+  file.open(filename, std::ios::out | std::ios::trunc | std::ios::binary);
+  if (!file.is_open())
+  {
+    std::cout << "Error: cannot open the mutation log " << filename << ".\n";
+    exit(EXIT_FAILURE);
+  }
+  genealogy_header header;
+  memcpy(header.magic, magic, 8);
+  header.version  = MUTATION_LOG_VERSION;
+  header.row_size = row_size;
+  file.write((const char*)&header, sizeof(genealogy_header));
+}
+
+/**
+ * \brief    Record the fate of an event
+ * \details  Appends the fate row, and counts the event in the statistics if
+ *           it was appended after the last reset
+ * \param    unsigned long long int event
+ * \param    uint32_t fate
+ * \return   \e void
+ */
+void MutationLog::add_fate( unsigned long long int event, uint32_t fate )
+{
+  assert(_fates_file.is_open());
+  std::unordered_map<unsigned long long int, mutation_origin>::iterator it = _segregating.find(event);
+  assert(it != _segregating.end());
+  mutation_fate row;
+  row.identifier = (uint64_t)event;
+  row.generation = (int32_t)_generation;
+  row.fate       = fate;
+  _fates_file.write((const char*)&row, sizeof(mutation_fate));
+  if (event >= _first_counted)
+  {
+    fixation_statistics& bin = _bins[it->second.bin];
+    if (fate == MUTATION_FIXED)
+    {
+      bin.fixed++;
+      bin.fixation_time += (double)(_generation-it->second.generation);
+    }
+    else
+    {
+      bin.lost++;
+    }
+  }
+  _segregating.erase(it);
+}
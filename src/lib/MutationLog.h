@@ -0,0 +1,157 @@
+
+/**
+ * \file      MutationLog.h
+ * \authors   Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * \date      18-10-2026
+ * \copyright Copyright (C) 2016-2020 Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard. All rights reserved
+ * \license   This project is released under the GNU General Public License
+ * \brief     MutationLog class declaration
+ */
+
+/***********************************************************************
+ * Copyright (C) 2016-2020
+ * Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * Web: https://github.com/charlesrocabert/SigmaFGM/
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#ifndef __SigmaFGM__MutationLog__
+#define __SigmaFGM__MutationLog__
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <unordered_map>
+#include <assert.h>
+
+#include "Macros.h"
+#include "Enums.h"
+#include "Structs.h"
+
+
+class MutationLog
+{
+  
+public:
+  
+  /*----------------------------
+   * CONSTRUCTORS
+   *----------------------------*/
+  MutationLog( void ) = delete;
+  MutationLog( std::string events_filename, std::string fates_filename, int population_size );
+  MutationLog( const MutationLog& log ) = delete;
+  
+  /*----------------------------
+   * DESTRUCTORS
+   *----------------------------*/
+  ~MutationLog( void );
+  
+  /*----------------------------
+   * GETTERS
+   *----------------------------*/
+  inline unsigned long long int get_number_of_events( void ) const;
+  inline unsigned long long int get_number_of_segregating_events( void ) const;
+  
+  /*----------------------------
+   * SETTERS
+   *----------------------------*/
+  MutationLog& operator=(const MutationLog&) = delete;
+  
+  inline void set_generation( int generation );
+  
+  /*----------------------------
+   * PUBLIC METHODS
+   *----------------------------*/
+  unsigned long long int add_event( const lineage_record& parent, const lineage_record& mutant );
+  void                   add_fixation( unsigned long long int event );
+  void                   add_loss( unsigned long long int event );
+  void                   reset_statistics( void );
+  void                   write_fixation_statistics( void );
+  void                   flush( void );
+  void                   close( void );
+  
+  /*----------------------------
+   * PUBLIC ATTRIBUTES
+   *----------------------------*/
+  
+protected:
+  
+  /*----------------------------
+   * PROTECTED METHODS
+   *----------------------------*/
+  void open_table( std::ofstream& file, std::string filename, const char* magic, uint32_t row_size );
+  void add_fate( unsigned long long int event, uint32_t fate );
+  
+  /*----------------------------
+   * PROTECTED ATTRIBUTES
+   *----------------------------*/
+  std::ofstream                                               _events_file;      /*!< Event table file                          */
+  std::ofstream                                               _fates_file;       /*!< Fate table file                           */
+  int                                                         _population_size;  /*!< Population size (scales the effect sizes) */
+  int                                                         _generation;       /*!< Current generation                        */
+  unsigned long long int                                      _number_of_events; /*!< Number of events written                  */
+  unsigned long long int                                      _first_counted;    /*!< First event counted in the statistics     */
+  std::unordered_map<unsigned long long int, mutation_origin> _segregating;      /*!< Events whose fate is unknown              */
+  std::vector<fixation_statistics>                            _bins;             /*!< Fates by effect size bin                  */
+};
+
+
+/*----------------------------
+ * GETTERS
+ *----------------------------*/
+
+/**
+ * \brief    Get the number of events written
+ * \details  --
+ * \param    void
+ * \return   \e unsigned long long int
+ */
+inline unsigned long long int MutationLog::get_number_of_events( void ) const
+{
+  return _number_of_events;
+}
+
+/**
+ * \brief    Get the number of segregating events
+ * \details  Events neither fixed nor lost yet
+ * \param    void
+ * \return   \e unsigned long long int
+ */
+inline unsigned long long int MutationLog::get_number_of_segregating_events( void ) const
+{
+  return (unsigned long long int)_segregating.size();
+}
+
+/*----------------------------
+ * SETTERS
+ *----------------------------*/
+
+/**
+ * \brief    Set the current generation
+ * \details  Fates are dated with the generation being computed
+ * \param    int generation
+ * \return   \e void
+ */
+inline void MutationLog::set_generation( int generation )
+{
+  _generation = generation;
+}
+
+
+#endif /* defined(__SigmaFGM__MutationLog__) */
@@ -44,8 +44,13 @@ Parameters::Parameters( void )
 {
   /*----------------------------------------------- PSEUDORANDOM NUMBERS GENERATOR SEED */
   
-  _prng = new Prng();
-  _seed = 0;
+  _prng                  = new Prng();
+  _prng_type             = MT19937;
+  _gaussian_sampler      = ZIGGURAT;
+  _seed                  = 0;
+  _number_of_replicates  = 1;
+  _common_random_numbers = false;
+  _variant               = 0;
   
   /*----------------------------------------------- SIMULATION TIME */
   
@@ -66,12 +71,19 @@ Parameters::Parameters( void )
   
   /*----------------------------------------------- POPULATION */
   
-  _population_size = 0.0;
-  _initial_mu      = 0.0;
-  _initial_sigma   = 0.0;
-  _initial_theta   = 0.0;
-  _oneD_shift      = false;
-  _mean_fitness    = false;
+  _population_size  = 0.0;
+  _initial_mu       = 0.0;
+  _initial_sigma    = 0.0;
+  _initial_theta    = 0.0;
+  _oneD_shift       = false;
+  _mean_fitness     = false;
+  _skip_monomorphic = false;
+  
+  /*----------------------------------------------- DEMES */
+  
+  _number_of_demes    = 1;
+  _migration_rate     = 0.0;
+  _migration_interval = 1;
   
   /*----------------------------------------------- MUTATIONS */
   
@@ -85,6 +97,28 @@ Parameters::Parameters( void )
   /*----------------------------------------------- NOISE PROPERTIES */
   
   _noise_type = NONE;
+  
+  /*----------------------------------------------- SELECTION */
+  
+  _selection_sampler = GSL_MULTINOMIAL;
+  _population_model  = WRIGHT_FISHER;
+  
+  /*----------------------------------------------- LINEAGES */
+  
+  _lineage_tracking   = false;
+  _collapse_unary     = false;
+  _genealogy_interval = 0;
+  _fixation_stop      = 0;
+  _lineage_log        = false;
+  _focal_sample_size  = 0;
+  _mutation_log       = false;
+  
+  /*----------------------------------------------- PARALLELISM */
+  
+  _number_of_threads = 0;
+  _pin_threads       = false;
+  _hugepages         = false;
+  _async_output      = false;
 }
 
 /*----------------------------
@@ -117,6 +151,12 @@ void Parameters::print_parameters( void )
 {
   std::cout << "### Parameters ########################\n";
   std::cout << "seed                    " << _seed << "\n";
+  std::cout << "prng                    " << Prng::get_type_name(_prng_type) << "\n";
+  if (_gaussian_sampler == ZIGGURAT) std::cout << "gaussian                ZIGGURAT\n";
+  else if (_gaussian_sampler == BOX_MULLER) std::cout << "gaussian                BOXMULLER\n";
+  std::cout << "replicates              " << _number_of_replicates << "\n";
+  std::cout << "common random numbers   " << _common_random_numbers << "\n";
+  std::cout << "variant                 " << _variant << "\n";
   std::cout << "stabilizing generations " << _stabilizing_generations << "\n";
   std::cout << "generations             " << _generations << "\n";
   std::cout << "shutoff distance        " << _shutoff_distance << "\n";
@@ -131,6 +171,10 @@ void Parameters::print_parameters( void )
   std::cout << "initial theta           " << _initial_theta << "\n";
   std::cout << "1d shift                " << _oneD_shift << "\n";
   std::cout << "mean fitness            " << _mean_fitness << "\n";
+  std::cout << "skip monomorphic        " << _skip_monomorphic << "\n";
+  std::cout << "demes                   " << _number_of_demes << "\n";
+  std::cout << "migration rate          " << _migration_rate << "\n";
+  std::cout << "migration interval      " << _migration_interval << "\n";
   std::cout << "mu mut rate             " << _m_mu << "\n";
   std::cout << "sigma mut rate          " << _m_sigma << "\n";
   std::cout << "theta mut rate          " << _m_theta << "\n";
@@ -141,5 +185,22 @@ void Parameters::print_parameters( void )
   else if (_noise_type == ISOTROPIC) std::cout << "noise type              ISOTROPIC\n";
   else if (_noise_type == UNCORRELATED) std::cout << "noise type              UNCORRELATED\n";
   else if (_noise_type == FULL) std::cout << "noise type              FULL\n";
+  if (_selection_sampler == GSL_MULTINOMIAL) std::cout << "selection               GSL\n";
+  else if (_selection_sampler == CONDITIONAL_BINOMIAL) std::cout << "selection               BINOMIAL\n";
+  else if (_selection_sampler == SORTED_UNIFORMS) std::cout << "selection               SORTED\n";
+  else if (_selection_sampler == BINOMIAL_SPLITTING) std::cout << "selection               SPLITTING\n";
+  if (_population_model == WRIGHT_FISHER) std::cout << "model                   WF\n";
+  else if (_population_model == MORAN) std::cout << "model                   MORAN\n";
+  std::cout << "lineage tracking        " << _lineage_tracking << "\n";
+  std::cout << "collapse unary          " << _collapse_unary << "\n";
+  std::cout << "genealogy interval      " << _genealogy_interval << "\n";
+  std::cout << "fixation stop           " << _fixation_stop << "\n";
+  std::cout << "lineage log             " << _lineage_log << "\n";
+  std::cout << "focal sample size       " << _focal_sample_size << "\n";
+  std::cout << "mutation log            " << _mutation_log << "\n";
+  std::cout << "threads                 " << _number_of_threads << "\n";
+  std::cout << "pin threads             " << _pin_threads << "\n";
+  std::cout << "huge pages              " << _hugepages << "\n";
+  std::cout << "async output            " << _async_output << "\n";
   std::cout << "#######################################\n";
 }
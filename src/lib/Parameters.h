@@ -62,7 +62,12 @@ public:
   /*----------------------------------------------- PSEUDORANDOM NUMBERS GENERATOR SEED */
   
   inline Prng*             get_prng( void );
+  inline prng_type         get_prng_type( void ) const;
+  inline gaussian_sampler  get_gaussian_sampler( void ) const;
   inline unsigned long int get_seed( void ) const;
+  inline int               get_number_of_replicates( void ) const;
+  inline bool              get_common_random_numbers( void ) const;
+  inline int               get_variant( void ) const;
   
   /*----------------------------------------------- SIMULATION TIME */
   
@@ -89,6 +94,13 @@ public:
   inline double get_initial_theta( void ) const;
   inline bool   get_oneD_shift( void ) const;
   inline bool   get_mean_fitness( void ) const;
+  inline bool   get_skip_monomorphic( void ) const;
+  
+  /*----------------------------------------------- DEMES */
+  
+  inline int    get_number_of_demes( void ) const;
+  inline double get_migration_rate( void ) const;
+  inline int    get_migration_interval( void ) const;
   
   /*----------------------------------------------- MUTATIONS */
   
@@ -103,6 +115,28 @@ public:
   
   inline type_of_noise get_noise_type( void ) const;
   
+  /*----------------------------------------------- SELECTION */
+  
+  inline selection_sampler get_selection_sampler( void ) const;
+  inline population_model  get_population_model( void ) const;
+  
+  /*----------------------------------------------- LINEAGES */
+  
+  inline bool get_lineage_tracking( void ) const;
+  inline bool get_collapse_unary( void ) const;
+  inline int  get_genealogy_interval( void ) const;
+  inline int  get_fixation_stop( void ) const;
+  inline bool get_lineage_log( void ) const;
+  inline int  get_focal_sample_size( void ) const;
+  inline bool get_mutation_log( void ) const;
+  
+  /*----------------------------------------------- PARALLELISM */
+  
+  inline int  get_number_of_threads( void ) const;
+  inline bool get_pin_threads( void ) const;
+  inline bool get_hugepages( void ) const;
+  inline bool get_async_output( void ) const;
+  
   /*----------------------------
    * SETTERS
    *----------------------------*/
@@ -111,7 +145,12 @@ public:
   /*----------------------------------------------- PSEUDORANDOM NUMBERS GENERATOR SEED */
   
   inline void set_prng( Prng* prng );
+  inline void set_prng_type( prng_type type );
+  inline void set_gaussian_sampler( gaussian_sampler sampler );
   inline void set_seed( unsigned long int seed );
+  inline void set_number_of_replicates( int number_of_replicates );
+  inline void set_common_random_numbers( bool common_random_numbers );
+  inline void set_variant( int variant );
   
   /*----------------------------------------------- SIMULATION TIME */
   
@@ -138,6 +177,13 @@ public:
   inline void set_initial_theta( double initial_theta );
   inline void set_oneD_shift( bool oneD_shift );
   inline void set_mean_fitness( bool mean_fitness );
+  inline void set_skip_monomorphic( bool skip_monomorphic );
+  
+  /*----------------------------------------------- DEMES */
+  
+  inline void set_number_of_demes( int number_of_demes );
+  inline void set_migration_rate( double migration_rate );
+  inline void set_migration_interval( int migration_interval );
   
   /*----------------------------------------------- MUTATIONS */
   
@@ -152,6 +198,28 @@ public:
   
   inline void set_noise_type( type_of_noise noise_type );
   
+  /*----------------------------------------------- SELECTION */
+  
+  inline void set_selection_sampler( selection_sampler sampler );
+  inline void set_population_model( population_model model );
+  
+  /*----------------------------------------------- LINEAGES */
+  
+  inline void set_lineage_tracking( bool lineage_tracking );
+  inline void set_collapse_unary( bool collapse_unary );
+  inline void set_genealogy_interval( int genealogy_interval );
+  inline void set_fixation_stop( int fixation_stop );
+  inline void set_lineage_log( bool lineage_log );
+  inline void set_focal_sample_size( int focal_sample_size );
+  inline void set_mutation_log( bool mutation_log );
+  
+  /*----------------------------------------------- PARALLELISM */
+  
+  inline void set_number_of_threads( int number_of_threads );
+  inline void set_pin_threads( bool pin_threads );
+  inline void set_hugepages( bool hugepages );
+  inline void set_async_output( bool async_output );
+  
   /*----------------------------
    * PUBLIC METHODS
    *----------------------------*/
@@ -173,8 +241,13 @@ protected:
   
   /*----------------------------------------------- PSEUDORANDOM NUMBERS GENERATOR SEED */
   
-  Prng*             _prng; /*!< Pseudorandom numbers generator */
-  unsigned long int _seed; /*!< Prng seed                      */
+  Prng*             _prng;                  /*!< Pseudorandom numbers generator               */
+  prng_type         _prng_type;             /*!< Algorithm of the main generators             */
+  gaussian_sampler  _gaussian_sampler;      /*!< Sampler of the gaussian blocks               */
+  unsigned long int _seed;                  /*!< Prng seed                                    */
+  int               _number_of_replicates;  /*!< Number of replicates (seeds) run in lockstep */
+  bool              _common_random_numbers; /*!< Events draw from aligned keyed streams       */
+  int               _variant;               /*!< Index of the paired parameter variant        */
   
   /*----------------------------------------------- SIMULATION TIME */
   
@@ -195,12 +268,19 @@ protected:
   
   /*----------------------------------------------- POPULATION */
   
-  int    _population_size; /*!< Number of particles                        */
-  double _initial_mu;      /*!< Initial mu value                           */
-  double _initial_sigma;   /*!< Initial sigma value                        */
-  double _initial_theta;   /*!< Initial theta value                        */
-  bool   _oneD_shift;      /*!< The population is shifted in one dimension */
-  bool   _mean_fitness;    /*!< The mean fitness is computed               */
+  int    _population_size;  /*!< Number of particles                         */
+  double _initial_mu;       /*!< Initial mu value                            */
+  double _initial_sigma;    /*!< Initial sigma value                         */
+  double _initial_theta;    /*!< Initial theta value                         */
+  bool   _oneD_shift;       /*!< The population is shifted in one dimension  */
+  bool   _mean_fitness;     /*!< The mean fitness is computed                */
+  bool   _skip_monomorphic; /*!< Monomorphic mutation-free phases are skipped */
+  
+  /*----------------------------------------------- DEMES */
+  
+  int    _number_of_demes;    /*!< Number of demes (islands)                    */
+  double _migration_rate;     /*!< Probability of migration of each individual  */
+  int    _migration_interval; /*!< Number of generations between two migrations */
   
   /*----------------------------------------------- MUTATIONS */
   
@@ -215,6 +295,28 @@ protected:
   
   type_of_noise _noise_type; /*!< Type of phenotypic noise (none, isotropic, ...) */
   
+  /*----------------------------------------------- SELECTION */
+  
+  selection_sampler _selection_sampler; /*!< Multinomial sampler used to draw offspring */
+  population_model  _population_model;  /*!< Population model (Wright-Fisher or Moran)  */
+  
+  /*----------------------------------------------- LINEAGES */
+  
+  bool _lineage_tracking;   /*!< The genealogy of the living population is kept          */
+  bool _collapse_unary;     /*!< Dead ancestors with a single child are removed          */
+  int  _genealogy_interval; /*!< Genealogy export interval in generations (0 if none)   */
+  int  _fixation_stop;      /*!< Fixed beneficial mutations stopping the run (0 if none) */
+  bool _lineage_log;        /*!< Only the ancestral lineages are kept, in a log          */
+  int  _focal_sample_size;  /*!< Individuals whose lineages are tracked (0 if all)       */
+  bool _mutation_log;       /*!< Mutation events and their fates are logged              */
+  
+  /*----------------------------------------------- PARALLELISM */
+  
+  int  _number_of_threads; /*!< Number of threads (0 for the sequential legacy path) */
+  bool _pin_threads;       /*!< Threads are pinned to cores                         */
+  bool _hugepages;         /*!< Large buffers are backed by huge pages              */
+  bool _async_output;      /*!< Statistics are written by an output thread          */
+  
 };
 
 
@@ -235,6 +337,28 @@ inline Prng* Parameters::get_prng( void )
   return _prng;
 }
 
+/**
+ * \brief    Get the algorithm of the main generators
+ * \details  --
+ * \param    void
+ * \return   \e prng_type
+ */
+inline prng_type Parameters::get_prng_type( void ) const
+{
+  return _prng_type;
+}
+
+/**
+ * \brief    Get the sampler of the gaussian blocks
+ * \details  --
+ * \param    void
+ * \return   \e gaussian_sampler
+ */
+inline gaussian_sampler Parameters::get_gaussian_sampler( void ) const
+{
+  return _gaussian_sampler;
+}
+
 /**
  * \brief    Get the prng seed
  * \details  --
@@ -246,6 +370,41 @@ inline unsigned long int Parameters::get_seed( void ) const
   return _seed;
 }
 
+/**
+ * \brief    Get the number of replicates
+ * \details  With MT19937, replicate k is run with the seed (seed+k). With
+ *           PHILOX, it draws from the keyed stream of replicate k
+ * \param    void
+ * \return   \e int
+ */
+inline int Parameters::get_number_of_replicates( void ) const
+{
+  return _number_of_replicates;
+}
+
+/**
+ * \brief    Get the common random numbers mode
+ * \details  When true, selection, mutations and phenotypes draw from keyed
+ *           streams aligned across paired parameter variants
+ * \param    void
+ * \return   \e bool
+ */
+inline bool Parameters::get_common_random_numbers( void ) const
+{
+  return _common_random_numbers;
+}
+
+/**
+ * \brief    Get the index of the paired parameter variant
+ * \details  0 for the base command line
+ * \param    void
+ * \return   \e int
+ */
+inline int Parameters::get_variant( void ) const
+{
+  return _variant;
+}
+
 /*----------------------------------------------- SIMULATION TIME */
 
 /**
@@ -409,6 +568,52 @@ inline bool Parameters::get_mean_fitness( void ) const
   return _mean_fitness;
 }
 
+/**
+ * \brief    Indicates if mutation-free generations of a monomorphic population are skipped
+ * \details  --
+ * \param    void
+ * \return   \e bool
+ */
+inline bool Parameters::get_skip_monomorphic( void ) const
+{
+  return _skip_monomorphic;
+}
+
+/*----------------------------------------------- DEMES */
+
+/**
+ * \brief    Get the number of demes
+ * \details  The population is split into demes of (almost) equal sizes
+ * \param    void
+ * \return   \e int
+ */
+inline int Parameters::get_number_of_demes( void ) const
+{
+  return _number_of_demes;
+}
+
+/**
+ * \brief    Get the migration rate
+ * \details  --
+ * \param    void
+ * \return   \e double
+ */
+inline double Parameters::get_migration_rate( void ) const
+{
+  return _migration_rate;
+}
+
+/**
+ * \brief    Get the number of generations between two migrations
+ * \details  --
+ * \param    void
+ * \return   \e int
+ */
+inline int Parameters::get_migration_interval( void ) const
+{
+  return _migration_interval;
+}
+
 /*----------------------------------------------- MUTATIONS */
 
 /**
@@ -490,6 +695,167 @@ inline type_of_noise Parameters::get_noise_type( void ) const
   return _noise_type;
 }
 
+/*----------------------------------------------- SELECTION */
+
+/**
+ * \brief    Get the selection sampler
+ * \details  All samplers are exact, but only GSL_MULTINOMIAL reproduces the
+ *           draws of previous versions for a given seed
+ * \param    void
+ * \return   \e selection_sampler
+ */
+inline selection_sampler Parameters::get_selection_sampler( void ) const
+{
+  return _selection_sampler;
+}
+
+/**
+ * \brief    Get the population model
+ * \details  With the Moran model, a generation is made of N birth-death events
+ * \param    void
+ * \return   \e population_model
+ */
+inline population_model Parameters::get_population_model( void ) const
+{
+  return _population_model;
+}
+
+/*----------------------------------------------- LINEAGES */
+
+/**
+ * \brief    Get the lineage tracking mode
+ * \details  When true, the genealogy of the living population is kept in the
+ *           lineage tree
+ * \param    void
+ * \return   \e bool
+ */
+inline bool Parameters::get_lineage_tracking( void ) const
+{
+  return _lineage_tracking;
+}
+
+/**
+ * \brief    Get the unary collapse mode of the lineage tree
+ * \details  When true, only the coalescence points of the living lineages
+ *           are kept
+ * \param    void
+ * \return   \e bool
+ */
+inline bool Parameters::get_collapse_unary( void ) const
+{
+  return _collapse_unary;
+}
+
+/**
+ * \brief    Get the genealogy export interval
+ * \details  Every interval generations, the ancestors shared by the whole
+ *           population are written in the genealogy tables and removed from
+ *           the lineage tree. 0 if the genealogy is not exported
+ * \param    void
+ * \return   \e int
+ */
+inline int Parameters::get_genealogy_interval( void ) const
+{
+  return _genealogy_interval;
+}
+
+/**
+ * \brief    Get the fixation stop
+ * \details  The run stops when this number of beneficial mutations (mu
+ *           mutations increasing W(mu)) has fixed since its start. 0 if the run does not stop on fixations
+ * \param    void
+ * \return   \e int
+ */
+inline int Parameters::get_fixation_stop( void ) const
+{
+  return _fixation_stop;
+}
+
+/**
+ * \brief    Get the lineage log mode
+ * \details  When true, each living individual only references its ancestors
+ *           in a log of records, reclaimed with the lineages (lighter than the
+ *           lineage tree, which also keeps the children of each node)
+ * \param    void
+ * \return   \e bool
+ */
+inline bool Parameters::get_lineage_log( void ) const
+{
+  return _lineage_log;
+}
+
+/**
+ * \brief    Get the focal sample size
+ * \details  Number of individuals whose lineages are tracked in each
+ *           generation. 0 if the lineages of the whole population are tracked
+ * \param    void
+ * \return   \e int
+ */
+inline int Parameters::get_focal_sample_size( void ) const
+{
+  return _focal_sample_size;
+}
+
+/**
+ * \brief    Get the mutation log mode
+ * \details  When true, every mutation event of the lineage tree is appended
+ *           to a binary log, with its fixation or loss
+ * \param    void
+ * \return   \e bool
+ */
+inline bool Parameters::get_mutation_log( void ) const
+{
+  return _mutation_log;
+}
+
+/*----------------------------------------------- PARALLELISM */
+
+/**
+ * \brief    Get the number of threads
+ * \details  With 0 threads, offspring share the main prng stream (legacy path).
+ *           Otherwise each offspring draws from its own substream, and the
+ *           results do not depend on the number of threads
+ * \param    void
+ * \return   \e int
+ */
+inline int Parameters::get_number_of_threads( void ) const
+{
+  return _number_of_threads;
+}
+
+/**
+ * \brief    Indicates if threads are pinned to cores
+ * \details  --
+ * \param    void
+ * \return   \e bool
+ */
+inline bool Parameters::get_pin_threads( void ) const
+{
+  return _pin_threads;
+}
+
+/**
+ * \brief    Indicates if large buffers are backed by huge pages
+ * \details  --
+ * \param    void
+ * \return   \e bool
+ */
+inline bool Parameters::get_hugepages( void ) const
+{
+  return _hugepages;
+}
+
+/**
+ * \brief    Check if statistics are written by an output thread
+ * \details  --
+ * \param    void
+ * \return   \e bool
+ */
+inline bool Parameters::get_async_output( void ) const
+{
+  return _async_output;
+}
+
 /*----------------------------
  * SETTERS
  *----------------------------*/
@@ -508,6 +874,34 @@ inline void Parameters::set_prng( Prng* prng )
   _prng = new Prng(*prng);
 }
 
+/**
+ * \brief    Set the algorithm of the main generators
+ * \details  The prng is replaced, and seeded again if a seed was given
+ * \param    prng_type type
+ * \return   \e void
+ */
+inline void Parameters::set_prng_type( prng_type type )
+{
+  delete _prng;
+  _prng      = new Prng(type);
+  _prng_type = type;
+  if (_seed != 0)
+  {
+    _prng->set_seed(_seed);
+  }
+}
+
+/**
+ * \brief    Set the sampler of the gaussian blocks
+ * \details  --
+ * \param    gaussian_sampler sampler
+ * \return   \e void
+ */
+inline void Parameters::set_gaussian_sampler( gaussian_sampler sampler )
+{
+  _gaussian_sampler = sampler;
+}
+
 /**
  * \brief    Set the prng seed
  * \details  --
@@ -520,6 +914,41 @@ inline void Parameters::set_seed( unsigned long int seed )
   _seed = seed;
 }
 
+/**
+ * \brief    Set the number of replicates
+ * \details  --
+ * \param    int number_of_replicates
+ * \return   \e void
+ */
+inline void Parameters::set_number_of_replicates( int number_of_replicates )
+{
+  assert(number_of_replicates > 0);
+  _number_of_replicates = number_of_replicates;
+}
+
+/**
+ * \brief    Set the common random numbers mode
+ * \details  --
+ * \param    bool common_random_numbers
+ * \return   \e void
+ */
+inline void Parameters::set_common_random_numbers( bool common_random_numbers )
+{
+  _common_random_numbers = common_random_numbers;
+}
+
+/**
+ * \brief    Set the index of the paired parameter variant
+ * \details  --
+ * \param    int variant
+ * \return   \e void
+ */
+inline void Parameters::set_variant( int variant )
+{
+  assert(variant >= 0);
+  _variant = variant;
+}
+
 /*----------------------------------------------- SIMULATION TIME */
 
 /**
@@ -693,6 +1122,56 @@ inline void Parameters::set_mean_fitness( bool mean_fitness )
   _mean_fitness = mean_fitness;
 }
 
+/**
+ * \brief    Skip mutation-free generations of a monomorphic population
+ * \details  --
+ * \param    bool skip_monomorphic
+ * \return   \e void
+ */
+inline void Parameters::set_skip_monomorphic( bool skip_monomorphic )
+{
+  _skip_monomorphic = skip_monomorphic;
+}
+
+/*----------------------------------------------- DEMES */
+
+/**
+ * \brief    Set the number of demes
+ * \details  --
+ * \param    int number_of_demes
+ * \return   \e void
+ */
+inline void Parameters::set_number_of_demes( int number_of_demes )
+{
+  assert(number_of_demes > 0);
+  _number_of_demes = number_of_demes;
+}
+
+/**
+ * \brief    Set the migration rate
+ * \details  --
+ * \param    double migration_rate
+ * \return   \e void
+ */
+inline void Parameters::set_migration_rate( double migration_rate )
+{
+  assert(migration_rate >= 0.0);
+  assert(migration_rate <= 1.0);
+  _migration_rate = migration_rate;
+}
+
+/**
+ * \brief    Set the number of generations between two migrations
+ * \details  --
+ * \param    int migration_interval
+ * \return   \e void
+ */
+inline void Parameters::set_migration_interval( int migration_interval )
+{
+  assert(migration_interval > 0);
+  _migration_interval = migration_interval;
+}
+
 /*----------------------------------------------- MUTATIONS */
 
 /**
@@ -783,5 +1262,155 @@ inline void Parameters::set_noise_type( type_of_noise noise_type )
   _noise_type = noise_type;
 }
 
+/*----------------------------------------------- SELECTION */
+
+/**
+ * \brief    Set the selection sampler
+ * \details  --
+ * \param    selection_sampler sampler
+ * \return   \e void
+ */
+inline void Parameters::set_selection_sampler( selection_sampler sampler )
+{
+  _selection_sampler = sampler;
+}
+
+/**
+ * \brief    Set the population model
+ * \details  --
+ * \param    population_model model
+ * \return   \e void
+ */
+inline void Parameters::set_population_model( population_model model )
+{
+  _population_model = model;
+}
+
+/*----------------------------------------------- LINEAGES */
+
+/**
+ * \brief    Set the lineage tracking mode
+ * \details  --
+ * \param    bool lineage_tracking
+ * \return   \e void
+ */
+inline void Parameters::set_lineage_tracking( bool lineage_tracking )
+{
+  _lineage_tracking = lineage_tracking;
+}
+
+/**
+ * \brief    Set the unary collapse mode of the lineage tree
+ * \details  --
+ * \param    bool collapse_unary
+ * \return   \e void
+ */
+inline void Parameters::set_collapse_unary( bool collapse_unary )
+{
+  _collapse_unary = collapse_unary;
+}
+
+/**
+ * \brief    Set the genealogy export interval
+ * \details  --
+ * \param    int genealogy_interval
+ * \return   \e void
+ */
+inline void Parameters::set_genealogy_interval( int genealogy_interval )
+{
+  _genealogy_interval = genealogy_interval;
+}
+
+/**
+ * \brief    Set the fixation stop
+ * \details  --
+ * \param    int fixation_stop
+ * \return   \e void
+ */
+inline void Parameters::set_fixation_stop( int fixation_stop )
+{
+  _fixation_stop = fixation_stop;
+}
+
+/**
+ * \brief    Set the lineage log mode
+ * \details  --
+ * \param    bool lineage_log
+ * \return   \e void
+ */
+inline void Parameters::set_lineage_log( bool lineage_log )
+{
+  _lineage_log = lineage_log;
+}
+
+/**
+ * \brief    Set the focal sample size
+ * \details  --
+ * \param    int focal_sample_size
+ * \return   \e void
+ */
+inline void Parameters::set_focal_sample_size( int focal_sample_size )
+{
+  _focal_sample_size = focal_sample_size;
+}
+
+/**
+ * \brief    Set the mutation log mode
+ * \details  --
+ * \param    bool mutation_log
+ * \return   \e void
+ */
+inline void Parameters::set_mutation_log( bool mutation_log )
+{
+  _mutation_log = mutation_log;
+}
+
+/*----------------------------------------------- PARALLELISM */
+
+/**
+ * \brief    Set the number of threads
+ * \details  --
+ * \param    int number_of_threads
+ * \return   \e void
+ */
+inline void Parameters::set_number_of_threads( int number_of_threads )
+{
+  assert(number_of_threads >= 0);
+  _number_of_threads = number_of_threads;
+}
+
+/**
+ * \brief    Pin threads to cores
+ * \details  --
+ * \param    bool pin_threads
+ * \return   \e void
+ */
+inline void Parameters::set_pin_threads( bool pin_threads )
+{
+  _pin_threads = pin_threads;
+}
+
+/**
+ * \brief    Back large buffers by huge pages
+ * \details  --
+ * \param    bool hugepages
+ * \return   \e void
+ */
+inline void Parameters::set_hugepages( bool hugepages )
+{
+  _hugepages = hugepages;
+}
+
+/**
+ * \brief    Set if statistics are written by an output thread
+ * \details  --
+ * \param    bool async_output
+ * \return   \e void
+ */
+inline void Parameters::set_async_output( bool async_output )
+{
+  _async_output = async_output;
+}
+
 
 #endif /* defined(__SigmaFGM__Parameters__) */
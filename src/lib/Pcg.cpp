@@ -0,0 +1,119 @@
+/**
+ * \file      Pcg.cpp
+ * \authors   Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * \date      18-10-2026
+ * \copyright Copyright (C) 2016-2020 Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard. All rights reserved
+ * \license   This project is released under the GNU General Public License
+ * \brief     Pcg class definition
+ */
+
+/***********************************************************************
+ * Copyright (C) 2016-2020
+ * Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * Web: https://github.com/charlesrocabert/SigmaFGM/
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#include "Pcg.h"
+
+const gsl_rng_type Pcg::_gsl_type =
+{
+  "pcg64",
+  0xFFFFFFFFUL,
+  0,
+  sizeof(pcg_state),
+  &Pcg::set,
+  &Pcg::get,
+  &Pcg::get_double
+};
+
+
+/*----------------------------
+ * GETTERS
+ *----------------------------*/
+
+/**
+ * \brief    Get the GSL generator type
+ * \details  Allows the generator to be used through gsl_rng and Prng
+ * \param    void
+ * \return   \e const gsl_rng_type*
+ */
+const gsl_rng_type* Pcg::get_gsl_type( void )
+{
+  return &_gsl_type;
+}
+
+/*----------------------------
+ * PUBLIC METHODS
+ *----------------------------*/
+
+/**
+ * \brief    Fill a block with uniform draws in [0,1)
+ * \details  Gives the same values as n calls to uniform()
+ * \param    pcg_state* state
+ * \param    double* x
+ * \param    int n
+ * \return   \e void
+ */
+void Pcg::fill_uniform( pcg_state* state, double* x, int n )
+{
+  for (int i = 0; i < n; i++)
+  {
+    x[i] = uniform(state);
+  }
+}
+
+/*----------------------------
+ * PROTECTED METHODS
+ *----------------------------*/
+
+/**
+ * \brief    Seed the generator (gsl_rng_set)
+ * \details  Same seeding as pcg64_oneseq: the seed is added to the state
+ *           between two steps
+ * \param    void* state
+ * \param    unsigned long int seed
+ * \return   \e void
+ */
+void Pcg::set( void* state, unsigned long int seed )
+{
+  pcg_state* s = (pcg_state*)state;
+  s->state     = 0;
+  next(s);
+  s->state    += (pcg_uint128)seed;
+  next(s);
+}
+
+/**
+ * \brief    Draw 32 random bits (gsl_rng_get)
+ * \details  Upper bits of the 64-bit output
+ * \param    void* state
+ * \return   \e unsigned long int
+ */
+unsigned long int Pcg::get( void* state )
+{
+  return (unsigned long int)(next((pcg_state*)state) >> 32);
+}
+
+/**
+ * \brief    Draw a uniform double in [0,1) (gsl_rng_uniform)
+ * \details  --
+ * \param    void* state
+ * \return   \e double
+ */
+double Pcg::get_double( void* state )
+{
+  return uniform((pcg_state*)state);
+}
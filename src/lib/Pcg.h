@@ -0,0 +1,136 @@
+/**
+ * \file      Pcg.h
+ * \authors   Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * \date      18-10-2026
+ * \copyright Copyright (C) 2016-2020 Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard. All rights reserved
+ * \license   This project is released under the GNU General Public License
+ * \brief     Pcg class declaration
+ */
+
+/***********************************************************************
+ * Copyright (C) 2016-2020
+ * Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * Web: https://github.com/charlesrocabert/SigmaFGM/
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#ifndef __SigmaFGM__Pcg__
+#define __SigmaFGM__Pcg__
+
+#include <iostream>
+#include <cstdint>
+#include <gsl/gsl_rng.h>
+#include <assert.h>
+
+#include "Macros.h"
+#include "Enums.h"
+#include "Structs.h"
+
+/* 128-bit LCG multiplier and default increment (O'Neill 2014) */
+#define PCG_MULTIPLIER (((pcg_uint128)2549297995355413924ULL << 64) | 4865540595714422341ULL)
+#define PCG_INCREMENT  (((pcg_uint128)6364136223846793005ULL << 64) | 1442695040888963407ULL)
+
+
+class Pcg
+{
+  
+public:
+  
+  /*----------------------------
+   * CONSTRUCTORS
+   *----------------------------*/
+  Pcg( void ) = delete;
+  Pcg( const Pcg& pcg ) = delete;
+  
+  /*----------------------------
+   * DESTRUCTORS
+   *----------------------------*/
+  
+  /*----------------------------
+   * GETTERS
+   *----------------------------*/
+  static const gsl_rng_type* get_gsl_type( void );
+  
+  /*----------------------------
+   * SETTERS
+   *----------------------------*/
+  Pcg& operator=(const Pcg&) = delete;
+  
+  /*----------------------------
+   * PUBLIC METHODS
+   *----------------------------*/
+  static inline uint64_t next( pcg_state* state );
+  static inline double   uniform( pcg_state* state );
+  static void            fill_uniform( pcg_state* state, double* x, int n );
+  
+  /*----------------------------
+   * PUBLIC ATTRIBUTES
+   *----------------------------*/
+  
+protected:
+  
+  /*----------------------------
+   * PROTECTED METHODS
+   *----------------------------*/
+  static void              set( void* state, unsigned long int seed );
+  static unsigned long int get( void* state );
+  static double            get_double( void* state );
+  
+  /*----------------------------
+   * PROTECTED ATTRIBUTES
+   *----------------------------*/
+  static const gsl_rng_type _gsl_type; /*!< GSL description of the generator */
+};
+
+
+/*----------------------------
+ * GETTERS
+ *----------------------------*/
+
+/*----------------------------
+ * SETTERS
+ *----------------------------*/
+
+/*----------------------------
+ * PUBLIC METHODS
+ *----------------------------*/
+
+/**
+ * \brief    Draw 64 random bits
+ * \details  PCG64: 128-bit LCG step, then XSL-RR output of the new state
+ * \param    pcg_state* state
+ * \return   \e uint64_t
+ */
+inline uint64_t Pcg::next( pcg_state* state )
+{
+  state->state   = state->state*PCG_MULTIPLIER+PCG_INCREMENT;
+  uint64_t xored = (uint64_t)(state->state >> 64)^(uint64_t)state->state;
+  unsigned rot   = (unsigned)(state->state >> 122);
+  return (xored >> rot) | (xored << ((64-rot) & 63));
+}
+
+/**
+ * \brief    Draw a uniform double in [0,1)
+ * \details  53 random bits
+ * \param    pcg_state* state
+ * \return   \e double
+ */
+inline double Pcg::uniform( pcg_state* state )
+{
+  return (double)(next(state) >> 11)/9007199254740992.0;
+}
+
+
+#endif /* defined(__SigmaFGM__Pcg__) */
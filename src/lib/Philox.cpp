@@ -0,0 +1,190 @@
+/**
+ * \file      Philox.cpp
+ * \authors   Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * \date      18-10-2026
+ * \copyright Copyright (C) 2016-2020 Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard. All rights reserved
+ * \license   This project is released under the GNU General Public License
+ * \brief     Philox class definition
+ */
+
+/***********************************************************************
+ * Copyright (C) 2016-2020
+ * Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * Web: https://github.com/charlesrocabert/SigmaFGM/
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#include "Philox.h"
+
+/* Philox4x32 multipliers and Weyl key increments (Salmon et al. 2011) */
+#define PHILOX_M0 0xD2511F53u
+#define PHILOX_M1 0xCD9E8D57u
+#define PHILOX_W0 0x9E3779B9u
+#define PHILOX_W1 0xBB67AE85u
+
+/* Number of rounds */
+#define PHILOX_ROUNDS 10
+
+const gsl_rng_type Philox::_gsl_type =
+{
+  "philox4x32-10",
+  0xFFFFFFFFUL,
+  0,
+  sizeof(philox_state),
+  &Philox::set,
+  &Philox::get,
+  &Philox::get_double
+};
+
+
+/*----------------------------
+ * GETTERS
+ *----------------------------*/
+
+/**
+ * \brief    Get the GSL generator type
+ * \details  Allows Philox streams to be used through gsl_rng and Prng
+ * \param    void
+ * \return   \e const gsl_rng_type*
+ */
+const gsl_rng_type* Philox::get_gsl_type( void )
+{
+  return &_gsl_type;
+}
+
+/*----------------------------
+ * SETTERS
+ *----------------------------*/
+
+/**
+ * \brief    Position a generator at the start of a keyed stream
+ * \details  The seed is the key. The counter holds the block index (word 0),
+ *           the slot (word 1), the generation (word 2), and the replicate and
+ *           purpose of the stream (word 3, 24 and 8 bits). Streams with
+ *           different identifiers never overlap, and any stream can be
+ *           generated on any thread in any order. A sequential stream may
+ *           carry its block index into words 1 and 2, since it only uses
+ *           the slot and generation 0
+ * \param    void* state
+ * \param    unsigned long int seed
+ * \param    unsigned int replicate
+ * \param    unsigned int generation
+ * \param    unsigned int slot
+ * \param    prng_stream stream
+ * \return   \e void
+ */
+void Philox::set_stream( void* state, unsigned long int seed, unsigned int replicate, unsigned int generation, unsigned int slot, prng_stream stream )
+{
+  assert(replicate < (1u<<24));
+  philox_state* s = (philox_state*)state;
+  s->key[0]       = (unsigned int)((uint64_t)seed & 0xFFFFFFFFu);
+  s->key[1]       = (unsigned int)((uint64_t)seed >> 32);
+  s->counter[0]   = 0;
+  s->counter[1]   = slot;
+  s->counter[2]   = generation;
+  s->counter[3]   = (replicate << 8) | (unsigned int)stream;
+  s->position     = 4;
+}
+
+/*----------------------------
+ * PUBLIC METHODS
+ *----------------------------*/
+
+/**
+ * \brief    Compute the output block of a counter
+ * \details  Philox4x32-10 bijection
+ * \param    const unsigned int* counter
+ * \param    const unsigned int* key
+ * \param    unsigned int* output
+ * \return   \e void
+ */
+void Philox::compute_block( const unsigned int* counter, const unsigned int* key, unsigned int* output )
+{
+  uint32_t c0 = counter[0];
+  uint32_t c1 = counter[1];
+  uint32_t c2 = counter[2];
+  uint32_t c3 = counter[3];
+  uint32_t k0 = key[0];
+  uint32_t k1 = key[1];
+  for (int round = 0; round < PHILOX_ROUNDS; round++)
+  {
+    uint64_t p0 = (uint64_t)PHILOX_M0*c0;
+    uint64_t p1 = (uint64_t)PHILOX_M1*c2;
+    c0          = (uint32_t)(p1 >> 32)^c1^k0;
+    c1          = (uint32_t)p1;
+    c2          = (uint32_t)(p0 >> 32)^c3^k1;
+    c3          = (uint32_t)p0;
+    k0         += PHILOX_W0;
+    k1         += PHILOX_W1;
+  }
+  output[0] = c0;
+  output[1] = c1;
+  output[2] = c2;
+  output[3] = c3;
+}
+
+/**
+ * \brief    Fill a block with uniform draws in [0,1)
+ * \details  Gives the same values as n calls to uniform()
+ * \param    philox_state* state
+ * \param    double* x
+ * \param    int n
+ * \return   \e void
+ */
+void Philox::fill_uniform( philox_state* state, double* x, int n )
+{
+  for (int i = 0; i < n; i++)
+  {
+    x[i] = uniform(state);
+  }
+}
+
+/*----------------------------
+ * PROTECTED METHODS
+ *----------------------------*/
+
+/**
+ * \brief    Seed the generator (gsl_rng_set)
+ * \details  Positions the generator at the main stream of replicate 0
+ * \param    void* state
+ * \param    unsigned long int seed
+ * \return   \e void
+ */
+void Philox::set( void* state, unsigned long int seed )
+{
+  set_stream(state, seed, 0, 0, 0, MAIN_STREAM);
+}
+
+/**
+ * \brief    Draw 32 random bits (gsl_rng_get)
+ * \details  --
+ * \param    void* state
+ * \return   \e unsigned long int
+ */
+unsigned long int Philox::get( void* state )
+{
+  return next((philox_state*)state);
+}
+
+/**
+ * \brief    Draw a uniform double in [0,1) (gsl_rng_uniform)
+ * \details  --
+ * \param    void* state
+ * \return   \e double
+ */
+double Philox::get_double( void* state )
+{
+  return uniform((philox_state*)state);
+}
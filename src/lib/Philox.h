@@ -0,0 +1,141 @@
+/**
+ * \file      Philox.h
+ * \authors   Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * \date      18-10-2026
+ * \copyright Copyright (C) 2016-2020 Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard. All rights reserved
+ * \license   This project is released under the GNU General Public License
+ * \brief     Philox class declaration
+ */
+
+/***********************************************************************
+ * Copyright (C) 2016-2020
+ * Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * Web: https://github.com/charlesrocabert/SigmaFGM/
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#ifndef __SigmaFGM__Philox__
+#define __SigmaFGM__Philox__
+
+#include <iostream>
+#include <cstdint>
+#include <gsl/gsl_rng.h>
+#include <assert.h>
+
+#include "Macros.h"
+#include "Enums.h"
+#include "Structs.h"
+
+
+class Philox
+{
+  
+public:
+  
+  /*----------------------------
+   * CONSTRUCTORS
+   *----------------------------*/
+  Philox( void ) = delete;
+  Philox( const Philox& philox ) = delete;
+  
+  /*----------------------------
+   * DESTRUCTORS
+   *----------------------------*/
+  
+  /*----------------------------
+   * GETTERS
+   *----------------------------*/
+  static const gsl_rng_type* get_gsl_type( void );
+  
+  /*----------------------------
+   * SETTERS
+   *----------------------------*/
+  Philox& operator=(const Philox&) = delete;
+  
+  static void set_stream( void* state, unsigned long int seed, unsigned int replicate, unsigned int generation, unsigned int slot, prng_stream stream );
+  
+  /*----------------------------
+   * PUBLIC METHODS
+   *----------------------------*/
+  static void                compute_block( const unsigned int* counter, const unsigned int* key, unsigned int* output );
+  static inline unsigned int next( philox_state* state );
+  static inline double       uniform( philox_state* state );
+  static void                fill_uniform( philox_state* state, double* x, int n );
+  
+  /*----------------------------
+   * PUBLIC ATTRIBUTES
+   *----------------------------*/
+  
+protected:
+  
+  /*----------------------------
+   * PROTECTED METHODS
+   *----------------------------*/
+  static void              set( void* state, unsigned long int seed );
+  static unsigned long int get( void* state );
+  static double            get_double( void* state );
+  
+  /*----------------------------
+   * PROTECTED ATTRIBUTES
+   *----------------------------*/
+  static const gsl_rng_type _gsl_type; /*!< GSL description of the generator */
+};
+
+
+/*----------------------------
+ * GETTERS
+ *----------------------------*/
+
+/*----------------------------
+ * SETTERS
+ *----------------------------*/
+
+/*----------------------------
+ * PUBLIC METHODS
+ *----------------------------*/
+
+/**
+ * \brief    Draw 32 random bits
+ * \details  Each block gives four words, then the block index is incremented
+ * \param    philox_state* state
+ * \return   \e unsigned int
+ */
+inline unsigned int Philox::next( philox_state* state )
+{
+  if (state->position == 4)
+  {
+    compute_block(state->counter, state->key, state->output);
+    if (++state->counter[0] == 0 && ++state->counter[1] == 0)
+    {
+      state->counter[2]++;
+    }
+    state->position = 0;
+  }
+  return state->output[state->position++];
+}
+
+/**
+ * \brief    Draw a uniform double in [0,1)
+ * \details  32 random bits
+ * \param    philox_state* state
+ * \return   \e double
+ */
+inline double Philox::uniform( philox_state* state )
+{
+  return (double)next(state)/4294967296.0;
+}
+
+
+#endif /* defined(__SigmaFGM__Philox__) */
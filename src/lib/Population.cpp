@@ -29,6 +29,9 @@
 
 #include "Population.h"
 
+/* Number of offspring slots computed by a task of the thread pool */
+#define OFFSPRING_CHUNK_SIZE 16
+
 
 /*----------------------------
  * CONSTRUCTORS
@@ -36,37 +39,100 @@
 
 /**
  * \brief    Constructor
- * \details  --
+ * \details  The population draws from prng, which is the main prng or the
+ *           stream of a deme
  * \param    Parameters* parameters
  * \param    Environment* environment
  * \param    Tree* tree
+ * \param    LineageLog* lineage_log
+ * \param    ThreadPool* thread_pool
+ * \param    Prng* prng
+ * \param    int population_size
  * \return   \e void
  */
-Population::Population( Parameters* parameters, Environment* environment, Tree* tree )
+Population::Population( Parameters* parameters, Environment* environment, Tree* tree, LineageLog* lineage_log, ThreadPool* thread_pool, Prng* prng, int population_size )
 {
   assert(parameters != NULL);
   assert(environment != NULL);
+  assert(prng != NULL);
+  assert(population_size > 0);
   
   /*----------------------------------------------- PARAMETERS */
   
   _parameters         = parameters;
-  _prng               = _parameters->get_prng();
+  _prng               = prng;
+  _population_size    = population_size;
   _environment        = environment;
   _tree               = tree;
+  _lineage_log        = lineage_log;
   _current_identifier = 1;
   
+  /*----------------------------------------------- PARALLELISM */
+  
+  _thread_pool        = thread_pool;
+  _keyed_offspring    = (_thread_pool != NULL || _parameters->get_common_random_numbers());
+  _keyed_generations  = 0;
+  _slot_prngs         = NULL;
+  _parents            = NULL;
+  _chunk_accumulators = NULL;
+  if (_keyed_offspring)
+  {
+    _slot_prngs = new Prng*[_population_size];
+    _parents    = new int[_population_size];
+    for (int i = 0; i < _population_size; i++)
+    {
+      _parents[i] = 0;
+    }
+    int nb_chunks       = (_population_size+OFFSPRING_CHUNK_SIZE-1)/OFFSPRING_CHUNK_SIZE;
+    _chunk_accumulators = new StatisticsAccumulator*[nb_chunks];
+    for (int chunk = 0; chunk < nb_chunks; chunk++)
+    {
+      _chunk_accumulators[chunk] = new StatisticsAccumulator();
+    }
+  }
+  
+  /*----------------------------------------------- COMMON RANDOM NUMBERS */
+  
+  _common_random_numbers = _parameters->get_common_random_numbers();
+  _selection_prng        = NULL;
+  if (_common_random_numbers)
+  {
+    _selection_prng = new Prng(PHILOX);
+  }
+  
+  /*----------------------------------------------- FOCAL SAMPLE */
+  
+  _focal_sample_size = 0;
+  _focal_prng        = NULL;
+  _focal_slots       = NULL;
+  if ((_tree != NULL || _lineage_log != NULL) && _parameters->get_focal_sample_size() > 0)
+  {
+    _focal_sample_size = _parameters->get_focal_sample_size();
+    _focal_prng        = new Prng(PHILOX);
+    _focal_prng->set_stream(_parameters->get_seed(), 0, 0, 0, FOCAL_STREAM);
+    _focal_slots       = new int[_population_size];
+  }
+  
   /*----------------------------------------------- POPULATION */
   
-  _pop          = new Individual*[_parameters->get_population_size()];
-  _w            = new double[_parameters->get_population_size()];
-  _w_sum        = 0.0;
+  _pop      = new Individual*[_population_size];
+  _next_pop = new Individual*[_population_size];
+  create_individuals();
+  _accumulator          = new StatisticsAccumulator();
+  _accumulator_outdated = false;
+  _w                    = new double[_population_size];
+  _w_sum                = 0.0;
   int    best   = 0;
   double best_w = 0.0;
-  for (int i = 0; i < _parameters->get_population_size(); i++)
+  for (int i = 0; i < _population_size; i++)
   {
-    _pop[i] = new Individual(_prng, _parameters->get_number_of_dimensions(), _parameters->get_initial_mu(), _parameters->get_initial_sigma(), _parameters->get_initial_theta(), _parameters->get_oneD_shift(), _parameters->get_noise_type(), _environment->get_z_opt());
     _pop[i]->set_identifier(_current_identifier++);
     _pop[i]->set_generation(0);
+    if (_common_random_numbers)
+    {
+      _slot_prngs[i]->set_stream(_parameters->get_seed(), 0, 0, (unsigned int)i, INITIAL_STREAM);
+      _pop[i]->set_prng(_slot_prngs[i]);
+    }
     _pop[i]->build_phenotype();
     if (!_parameters->get_mean_fitness())
     {
@@ -76,7 +142,8 @@ Population::Population( Parameters* parameters, Environment* environment, Tree*
     {
       _pop[i]->compute_mean_fitness(_parameters->get_alpha(), _parameters->get_beta(), _parameters->get_Q());
     }
-    //_tree->add_root(_pop[i]);
+    record_root(_pop[i]);
+    _accumulator->add_individual(_pop[i]);
     _w[i]   = _pop[i]->get_Wz();
     _w_sum += _w[i];
     if (best_w < _w[i])
@@ -85,11 +152,32 @@ Population::Population( Parameters* parameters, Environment* environment, Tree*
       best   = i;
     }
   }
-  for (int i = 0; i < _parameters->get_population_size(); i++)
+  update_focal_sample();
+  
+  /*----------------------------------------------- GENERATION BUFFERS */
+  
+  _draws     = new unsigned int[_population_size];
+  _selection = new Selection(_parameters->get_selection_sampler(), _population_size, thread_pool);
+  
+  /*----------------------------------------------- MORAN MODEL */
+  
+  _fitness_tree     = NULL;
+  _mutation_pending = false;
+  if (_parameters->get_population_model() == MORAN)
+  {
+    _fitness_tree = new FenwickTree(_population_size);
+    _fitness_tree->build(_w);
+  }
+  
+  /*----------------------------------------------- MONOMORPHISM */
+  
+  _monomorphic_prng        = NULL;
+  _monomorphic_accumulator = NULL;
+  if (_parameters->get_skip_monomorphic())
   {
-    _w[i] /= _w_sum;
+    _monomorphic_prng        = new Prng(PHILOX);
+    _monomorphic_accumulator = new StatisticsAccumulator();
   }
-  //_tree->prune();
   //_pop[best]->write_mu(0);
   //_pop[best]->write_sigma(0);
   //_pop[best]->write_theta(0);
@@ -110,16 +198,89 @@ Population::~Population( void )
   _prng        = NULL;
   _environment = NULL;
   _tree        = NULL;
-  for (int i = 0; i < _parameters->get_population_size(); i++)
+  _lineage_log = NULL;
+  for (int i = 0; i < _population_size; i++)
   {
     delete _pop[i];
     _pop[i] = NULL;
+    delete _next_pop[i];
+    _next_pop[i] = NULL;
   }
   delete[] _pop;
   _pop = NULL;
+  delete[] _next_pop;
+  _next_pop = NULL;
   delete[] _w;
   _w = NULL;
-  _parameters = NULL;
+  delete[] _draws;
+  _draws = NULL;
+  delete _selection;
+  _selection = NULL;
+  delete _fitness_tree;
+  _fitness_tree = NULL;
+  delete _accumulator;
+  _accumulator = NULL;
+  delete _selection_prng;
+  _selection_prng = NULL;
+  delete _focal_prng;
+  _focal_prng = NULL;
+  delete[] _focal_slots;
+  _focal_slots = NULL;
+  delete _monomorphic_prng;
+  _monomorphic_prng = NULL;
+  delete _monomorphic_accumulator;
+  _monomorphic_accumulator = NULL;
+  if (_keyed_offspring)
+  {
+    for (int i = 0; i < _population_size; i++)
+    {
+      delete _slot_prngs[i];
+      _slot_prngs[i] = NULL;
+    }
+    delete[] _slot_prngs;
+    _slot_prngs = NULL;
+    delete[] _parents;
+    _parents = NULL;
+    int nb_chunks = (_population_size+OFFSPRING_CHUNK_SIZE-1)/OFFSPRING_CHUNK_SIZE;
+    for (int chunk = 0; chunk < nb_chunks; chunk++)
+    {
+      delete _chunk_accumulators[chunk];
+      _chunk_accumulators[chunk] = NULL;
+    }
+    delete[] _chunk_accumulators;
+    _chunk_accumulators = NULL;
+  }
+  _thread_pool = NULL;
+  _parameters  = NULL;
+}
+
+/*----------------------------
+ * SETTERS
+ *----------------------------*/
+
+/**
+ * \brief    Place an individual at position i
+ * \details  Used by migrations: the previous individual is not freed, it must
+ *           have been placed elsewhere by the caller. The individual now
+ *           draws from the population prng
+ * \param    int i
+ * \param    Individual* individual
+ * \return   \e void
+ */
+void Population::set_individual( int i, Individual* individual )
+{
+  assert(i >= 0);
+  assert(i < _population_size);
+  assert(individual != NULL);
+  _pop[i]               = individual;
+  _pop[i]->set_prng(_prng);
+  _w_sum               += individual->get_Wz()-_w[i];
+  _w[i]                 = individual->get_Wz();
+  _accumulator_outdated = true;
+  if (_fitness_tree != NULL)
+  {
+    _fitness_tree->set_weight(i, _w[i]);
+  }
 }
 
 /*----------------------------
@@ -128,38 +289,55 @@ Population::~Population( void )
 
 /**
  * \brief    Compute the next generation
- * \details  --
+ * \details  Offspring are copied into the individuals of the next generation
+ *           buffer, then both buffers swap roles: no memory is allocated
  * \param    int next_generation
  * \return   \e void
  */
 void Population::compute_next_generation( int next_generation )
 {
-  Individual**  new_pop   = new Individual*[_parameters->get_population_size()];
-  unsigned int* draws     = new unsigned int[_parameters->get_population_size()];
-  int           new_index = 0;
-  _w_sum                  = 0.0;
-  int    best             = 0;
-  double best_w           = 0.0;
-  _prng->multinomial(draws, _w, _parameters->get_population_size(), _parameters->get_population_size());
-  for (int i = 0; i < _parameters->get_population_size(); i++)
+  if (_fitness_tree != NULL)
+  {
+    compute_moran_events(next_generation);
+    return;
+  }
+  if (_mutation_pending)
+  {
+    compute_mutating_generation(next_generation);
+    return;
+  }
+  if (_keyed_offspring)
+  {
+    compute_keyed_generation(next_generation);
+    return;
+  }
+  _selection->draw(_prng, _w, _w_sum, _draws);
+  _accumulator->reset();
+  Individual** new_pop   = _next_pop;
+  int          new_index = 0;
+  _w_sum                 = 0.0;
+  int    best            = 0;
+  double best_w          = 0.0;
+  for (int i = 0; i < _population_size; i++)
   {
-    for (unsigned int j = 0; j < draws[i]; j++)
+    for (unsigned int j = 0; j < _draws[i]; j++)
     {
-      new_pop[new_index] = new Individual(*_pop[i]);
+      new_pop[new_index]->copy(*_pop[i]);
       new_pop[new_index]->mutate(_parameters->get_m_mu(), _parameters->get_m_sigma(), _parameters->get_m_theta(), _parameters->get_s_mu(), _parameters->get_s_sigma(), _parameters->get_s_theta());
       new_pop[new_index]->set_identifier(_current_identifier++);
       new_pop[new_index]->set_generation(next_generation);
       new_pop[new_index]->build_phenotype();
       if (!_parameters->get_mean_fitness())
       {
-        _pop[i]->compute_fitness(_parameters->get_alpha(), _parameters->get_beta(), _parameters->get_Q());
+        new_pop[new_index]->compute_fitness(_parameters->get_alpha(), _parameters->get_beta(), _parameters->get_Q());
       }
       else
       {
-        _pop[i]->compute_mean_fitness(_parameters->get_alpha(), _parameters->get_beta(), _parameters->get_Q());
+        new_pop[new_index]->compute_mean_fitness(_parameters->get_alpha(), _parameters->get_beta(), _parameters->get_Q());
       }
-      //_tree->add_reproduction_event(_pop[i], new_pop[new_index]);
-      _w[new_index]  = _pop[i]->get_Wz();
+      record_birth(_pop[i], new_pop[new_index]);
+      _accumulator->add_individual(new_pop[new_index]);
+      _w[new_index]  = new_pop[new_index]->get_Wz();
       _w_sum        += _w[new_index];
       if (best_w < _w[new_index])
       {
@@ -168,24 +346,574 @@ void Population::compute_next_generation( int next_generation )
       }
       new_index++;
     }
-    delete _pop[i];
-    _pop[i] = NULL;
-  }
-  delete[] _pop;
-  _pop = new_pop;
-  delete[] draws;
-  draws = NULL;
-  for (int i = 0; i < _parameters->get_population_size(); i++)
-  {
-    _w[i] /= _w_sum;
   }
-  //_tree->prune();
+  _next_pop = _pop;
+  _pop      = new_pop;
+  update_tree();
   //_pop[best]->write_mu(next_generation);
   //_pop[best]->write_sigma(next_generation);
   //_pop[best]->write_theta(next_generation);
 }
 
+/**
+ * \brief    Indicates if all the individuals carry the same genotype
+ * \details  --
+ * \param    void
+ * \return   \e bool
+ */
+bool Population::is_monomorphic( void ) const
+{
+  for (int i = 1; i < _population_size; i++)
+  {
+    if (!_pop[i]->has_same_genotype(*_pop[0]))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * \brief    Skip the generations of a monomorphic population until the next mutation
+ * \details  Selection among identical genotypes cannot change the genotypes,
+ *           so only the waiting time until the next mutation matters. It is
+ *           drawn from a geometric distribution, and the population is left
+ *           untouched for that many generations (at most the remaining ones).
+ *           The next generation computed then carries at least one mutation.
+ *           Returns the number of generations skipped
+ * \param    int remaining_generations
+ * \return   \e int
+ */
+int Population::skip_mutation_free_generations( int remaining_generations )
+{
+  assert(!_mutation_pending);
+  assert(_fitness_tree == NULL);
+  assert(_tree == NULL && _lineage_log == NULL);
+  assert(remaining_generations >= 0);
+  double p       = -expm1((double)_population_size*log1p(-offspring_mutation_probability()));
+  double skipped = _prng->geometric(p);
+  if (skipped >= (double)remaining_generations)
+  {
+    return remaining_generations;
+  }
+  _mutation_pending = true;
+  return (int)skipped;
+}
+
+/**
+ * \brief    Compute the expected statistics of a skipped generation
+ * \details  All the individuals carry the genotype of the monomorphic
+ *           population, so genotypic statistics are exact (with a null
+ *           standard deviation) and no mutation occurs. Phenotypic statistics
+ *           are estimated over MONOMORPHIC_DRAWS phenotypes of the genotype,
+ *           drawn from a Philox stream keyed by the generation, so that the
+ *           main prng stream is left untouched
+ * \param    int generation
+ * \return   \e StatisticsAccumulator*
+ */
+StatisticsAccumulator* Population::compute_monomorphic_statistics( int generation )
+{
+  assert(_monomorphic_prng != NULL);
+  assert(is_monomorphic());
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 1) Copy the genotype in a free buffer */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  Individual* genotype = _next_pop[0];
+  genotype->copy(*_pop[0]);
+  _monomorphic_prng->set_stream(_parameters->get_seed(), 0, (unsigned int)generation, 0, MONOMORPHIC_STREAM);
+  genotype->set_prng(_monomorphic_prng);
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 2) Accumulate the phenotype draws     */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  double values[NUMBER_OF_STATISTICS];
+  _monomorphic_accumulator->reset();
+  for (int d = 0; d < MONOMORPHIC_DRAWS; d++)
+  {
+    genotype->build_phenotype();
+    if (!_parameters->get_mean_fitness())
+    {
+      genotype->compute_fitness(_parameters->get_alpha(), _parameters->get_beta(), _parameters->get_Q());
+    }
+    else
+    {
+      genotype->compute_mean_fitness(_parameters->get_alpha(), _parameters->get_beta(), _parameters->get_Q());
+    }
+    values[DMU_STATISTIC]             = genotype->get_dmu();
+    values[DZ_STATISTIC]              = genotype->get_dz();
+    values[WMU_STATISTIC]             = genotype->get_Wmu();
+    values[WZ_STATISTIC]              = genotype->get_Wz();
+    values[EV_STATISTIC]              = genotype->get_max_Sigma_eigenvalue();
+    values[EV_CONTRIBUTION_STATISTIC] = genotype->get_max_Sigma_contribution();
+    values[EV_DOT_PRODUCT_STATISTIC]  = genotype->get_max_dot_product();
+    values[R_MU_STATISTIC]            = 0.0;
+    values[R_SIGMA_STATISTIC]         = 0.0;
+    values[R_THETA_STATISTIC]         = 0.0;
+    _monomorphic_accumulator->add_values(values);
+  }
+  return _monomorphic_accumulator;
+}
+
 /*----------------------------
  * PROTECTED METHODS
  *----------------------------*/
 
+/**
+ * \brief    Compute the next generation from keyed offspring streams
+ * \details  A prefix sum over the multinomial draws assigns each offspring to
+ *           a fixed slot, and each slot draws from its own Philox stream,
+ *           keyed by the seed, the number of generations already computed
+ *           with keyed streams (generation numbers restart after
+ *           stabilization) and the slot index. Slots are computed by fixed
+ *           chunks, on the thread pool if any, so the result does not depend
+ *           on the number of threads. With common random numbers, selection
+ *           also draws from a keyed stream, and mutations and phenotypes from
+ *           separate streams of the slot: the same event draws the same
+ *           numbers in every paired parameter variant
+ * \param    int next_generation
+ * \return   \e void
+ */
+void Population::compute_keyed_generation( int next_generation )
+{
+  int N = _population_size;
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 1) Assign offspring to slots          */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  unsigned int generation_key = _keyed_generations++;
+  if (_common_random_numbers)
+  {
+    _selection_prng->set_stream(_parameters->get_seed(), 0, generation_key, 0, SELECTION_STREAM);
+    _selection->draw(_selection_prng, _w, _w_sum, _draws);
+  }
+  else
+  {
+    _selection->draw(_prng, _w, _w_sum, _draws);
+  }
+  int slot = 0;
+  for (int i = 0; i < N; i++)
+  {
+    for (unsigned int j = 0; j < _draws[i]; j++)
+    {
+      _parents[slot] = i;
+      slot++;
+    }
+  }
+  assert(slot == N);
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 2) Compute offspring by chunks        */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  unsigned long long int first_identifier = _current_identifier;
+  int                    nb_chunks        = (N+OFFSPRING_CHUNK_SIZE-1)/OFFSPRING_CHUNK_SIZE;
+  auto compute_chunk = [&]( int chunk )
+  {
+    int first = chunk*OFFSPRING_CHUNK_SIZE;
+    int last  = (first+OFFSPRING_CHUNK_SIZE < N ? first+OFFSPRING_CHUNK_SIZE : N);
+    _chunk_accumulators[chunk]->reset();
+    for (int s = first; s < last; s++)
+    {
+      compute_offspring(s, next_generation, generation_key, first_identifier, _chunk_accumulators[chunk]);
+    }
+  };
+  if (_thread_pool != NULL)
+  {
+    _thread_pool->run_sharded(nb_chunks, compute_chunk);
+  }
+  else
+  {
+    for (int chunk = 0; chunk < nb_chunks; chunk++)
+    {
+      compute_chunk(chunk);
+    }
+  }
+  _current_identifier += (unsigned long long int)N;
+  if (_tree != NULL || _lineage_log != NULL)
+  {
+    /* Lineage events are added sequentially, in slot order */
+    for (int s = 0; s < N; s++)
+    {
+      record_birth(_pop[_parents[s]], _next_pop[s]);
+    }
+  }
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 3) Sum fitnesses and statistics       */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* Chunk statistics are merged in chunk order, so the result does not */
+  /* depend on the number of threads                                     */
+  _w_sum = 0.0;
+  for (int i = 0; i < N; i++)
+  {
+    _w_sum += _w[i];
+  }
+  _accumulator->reset();
+  for (int chunk = 0; chunk < nb_chunks; chunk++)
+  {
+    _accumulator->merge(_chunk_accumulators[chunk]);
+  }
+  Individual** tmp = _pop;
+  _pop             = _next_pop;
+  _next_pop        = tmp;
+  update_tree();
+}
+
+/**
+ * \brief    Create the individuals of both generation buffers
+ * \details  With a thread pool, each individual (and slot prng) is created
+ *           by the thread that will compute its slot, so that its memory is
+ *           first touched on the NUMA node of that thread. Initial values do
+ *           not depend on random draws
+ * \param    void
+ * \return   \e void
+ */
+void Population::create_individuals( void )
+{
+  auto create = [&]( int first, int last )
+  {
+    for (int i = first; i < last; i++)
+    {
+      _pop[i]      = new Individual(_prng, _parameters->get_number_of_dimensions(), _parameters->get_initial_mu(), _parameters->get_initial_sigma(), _parameters->get_initial_theta(), _parameters->get_oneD_shift(), _parameters->get_noise_type(), _environment->get_z_opt());
+      _next_pop[i] = new Individual(_prng, _parameters->get_number_of_dimensions(), _parameters->get_initial_mu(), _parameters->get_initial_sigma(), _parameters->get_initial_theta(), _parameters->get_oneD_shift(), _parameters->get_noise_type(), _environment->get_z_opt());
+      if (_keyed_offspring)
+      {
+        _slot_prngs[i] = new Prng(PHILOX);
+      }
+    }
+  };
+  if (_thread_pool != NULL)
+  {
+    int nb_chunks = (_population_size+OFFSPRING_CHUNK_SIZE-1)/OFFSPRING_CHUNK_SIZE;
+    _thread_pool->run_sharded(nb_chunks, [&]( int chunk )
+    {
+      int first = chunk*OFFSPRING_CHUNK_SIZE;
+      create(first, (first+OFFSPRING_CHUNK_SIZE < _population_size ? first+OFFSPRING_CHUNK_SIZE : _population_size));
+    });
+  }
+  else
+  {
+    create(0, _population_size);
+  }
+}
+
+/**
+ * \brief    Compute the offspring of a slot
+ * \details  Only touches the slot's individual, prng and fitness, and the
+ *           accumulator of its chunk, so slots can be computed concurrently
+ * \param    int slot
+ * \param    int next_generation
+ * \param    unsigned int generation_key
+ * \param    unsigned long long int first_identifier
+ * \param    StatisticsAccumulator* accumulator
+ * \return   \e void
+ */
+void Population::compute_offspring( int slot, int next_generation, unsigned int generation_key, unsigned long long int first_identifier, StatisticsAccumulator* accumulator )
+{
+  Prng*       prng      = _slot_prngs[slot];
+  Individual* offspring = _next_pop[slot];
+  prng->set_stream(_parameters->get_seed(), 0, generation_key, (unsigned int)slot, (_common_random_numbers ? MUTATION_STREAM : OFFSPRING_STREAM));
+  offspring->copy(*_pop[_parents[slot]]);
+  offspring->set_prng(prng);
+  offspring->mutate(_parameters->get_m_mu(), _parameters->get_m_sigma(), _parameters->get_m_theta(), _parameters->get_s_mu(), _parameters->get_s_sigma(), _parameters->get_s_theta());
+  offspring->set_identifier(first_identifier+(unsigned long long int)slot);
+  offspring->set_generation(next_generation);
+  if (_common_random_numbers)
+  {
+    prng->set_stream(_parameters->get_seed(), 0, generation_key, (unsigned int)slot, PHENOTYPE_STREAM);
+  }
+  offspring->build_phenotype();
+  if (!_parameters->get_mean_fitness())
+  {
+    offspring->compute_fitness(_parameters->get_alpha(), _parameters->get_beta(), _parameters->get_Q());
+  }
+  else
+  {
+    offspring->compute_mean_fitness(_parameters->get_alpha(), _parameters->get_beta(), _parameters->get_Q());
+  }
+  accumulator->add_individual(offspring);
+  _w[slot] = offspring->get_Wz();
+}
+
+/**
+ * \brief    Compute N birth-death events of the Moran model
+ * \details  Each event samples a reproducer proportionally to its fitness from
+ *           the Fenwick tree, and its offspring replaces an individual drawn
+ *           uniformly (possibly the reproducer itself). N events make one
+ *           generation, so that statistics stay comparable with the
+ *           Wright-Fisher model
+ * \param    int next_generation
+ * \return   \e void
+ */
+void Population::compute_moran_events( int next_generation )
+{
+  int N = _population_size;
+  for (int event = 0; event < N; event++)
+  {
+    /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+    /* 1) Draw the reproducer and the dead   */
+    /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+    int reproducer = _fitness_tree->sample(_prng->uniform()*_fitness_tree->get_total());
+    int dead       = _prng->uniform(0, N-1);
+    
+    /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+    /* 2) Compute the offspring              */
+    /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+    /* The first individual of the next generation buffer is recycled as   */
+    /* the offspring, and the dead individual takes its place              */
+    Individual* offspring = _next_pop[0];
+    offspring->copy(*_pop[reproducer]);
+    offspring->mutate(_parameters->get_m_mu(), _parameters->get_m_sigma(), _parameters->get_m_theta(), _parameters->get_s_mu(), _parameters->get_s_sigma(), _parameters->get_s_theta());
+    offspring->set_identifier(_current_identifier++);
+    offspring->set_generation(next_generation);
+    offspring->build_phenotype();
+    if (!_parameters->get_mean_fitness())
+    {
+      offspring->compute_fitness(_parameters->get_alpha(), _parameters->get_beta(), _parameters->get_Q());
+    }
+    else
+    {
+      offspring->compute_mean_fitness(_parameters->get_alpha(), _parameters->get_beta(), _parameters->get_Q());
+    }
+    
+    /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+    /* 3) Replace the dead individual        */
+    /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+    record_birth(_pop[reproducer], offspring);
+    record_death(_pop[dead]);
+    _next_pop[0] = _pop[dead];
+    _pop[dead]   = offspring;
+    _w[dead]     = offspring->get_Wz();
+    _fitness_tree->set_weight(dead, _w[dead]);
+  }
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 4) Rebuild the tree                   */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* Clears the rounding errors accumulated by the updates */
+  _fitness_tree->build(_w);
+  _w_sum                = _fitness_tree->get_total();
+  _accumulator_outdated = true;
+  update_focal_sample();
+}
+
+/**
+ * \brief    Compute a generation carrying at least one mutation
+ * \details  Follows skip_mutation_free_generations(). Since all the parents
+ *           carry the same genotype, selection is not drawn: offspring i is
+ *           the copy of parent i. The first mutant offspring is drawn from
+ *           the geometric distribution truncated to the population, offspring
+ *           before it do not mutate, and its mutated traits are drawn
+ *           conditionally to at least one mutation. Parents are not drawn,
+ *           so lineages cannot be tracked through skipped generations
+ * \param    int next_generation
+ * \return   \e void
+ */
+void Population::compute_mutating_generation( int next_generation )
+{
+  assert(_mutation_pending);
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 1) Draw the first mutant offspring    */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  double q            = offspring_mutation_probability();
+  double p_mutation   = -expm1((double)_population_size*log1p(-q));
+  int    first_mutant = (int)floor(log1p(-_prng->uniform()*p_mutation)/log1p(-q));
+  if (first_mutant >= _population_size)
+  {
+    first_mutant = _population_size-1;
+  }
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 2) Compute offspring                  */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  bool mutable_sigma = (_parameters->get_noise_type() != NONE);
+  bool mutable_theta = (_parameters->get_number_of_dimensions() > 1 && _parameters->get_noise_type() == FULL);
+  _w_sum             = 0.0;
+  _accumulator->reset();
+  for (int i = 0; i < _population_size; i++)
+  {
+    Individual* offspring = _next_pop[i];
+    offspring->copy(*_pop[i]);
+    offspring->set_prng(_prng);
+    if (i < first_mutant)
+    {
+      offspring->mutate(0.0, 0.0, 0.0, _parameters->get_s_mu(), _parameters->get_s_sigma(), _parameters->get_s_theta());
+    }
+    else if (i == first_mutant)
+    {
+      bool mu_mutation    = false;
+      bool sigma_mutation = false;
+      bool theta_mutation = false;
+      while (!mu_mutation && !sigma_mutation && !theta_mutation)
+      {
+        mu_mutation    = (_prng->uniform() < _parameters->get_m_mu());
+        sigma_mutation = (mutable_sigma && _prng->uniform() < _parameters->get_m_sigma());
+        theta_mutation = (mutable_theta && _prng->uniform() < _parameters->get_m_theta());
+      }
+      offspring->mutate((mu_mutation ? 1.0 : 0.0), (sigma_mutation ? 1.0 : 0.0), (theta_mutation ? 1.0 : 0.0), _parameters->get_s_mu(), _parameters->get_s_sigma(), _parameters->get_s_theta());
+    }
+    else
+    {
+      offspring->mutate(_parameters->get_m_mu(), _parameters->get_m_sigma(), _parameters->get_m_theta(), _parameters->get_s_mu(), _parameters->get_s_sigma(), _parameters->get_s_theta());
+    }
+    offspring->set_identifier(_current_identifier++);
+    offspring->set_generation(next_generation);
+    offspring->build_phenotype();
+    if (!_parameters->get_mean_fitness())
+    {
+      offspring->compute_fitness(_parameters->get_alpha(), _parameters->get_beta(), _parameters->get_Q());
+    }
+    else
+    {
+      offspring->compute_mean_fitness(_parameters->get_alpha(), _parameters->get_beta(), _parameters->get_Q());
+    }
+    record_birth(_pop[i], offspring);
+    _accumulator->add_individual(offspring);
+    _w[i]   = offspring->get_Wz();
+    _w_sum += _w[i];
+  }
+  Individual** tmp  = _pop;
+  _pop              = _next_pop;
+  _next_pop         = tmp;
+  _mutation_pending = false;
+  update_tree();
+}
+
+/**
+ * \brief    Get the probability that an offspring carries at least one mutation
+ * \details  Sigma only mutates with phenotypic noise, and theta only with
+ *           full noise in more than one dimension
+ * \param    void
+ * \return   \e double
+ */
+double Population::offspring_mutation_probability( void ) const
+{
+  double no_mutation = 1.0-_parameters->get_m_mu();
+  if (_parameters->get_noise_type() != NONE)
+  {
+    no_mutation *= 1.0-_parameters->get_m_sigma();
+  }
+  if (_parameters->get_number_of_dimensions() > 1 && _parameters->get_noise_type() == FULL)
+  {
+    no_mutation *= 1.0-_parameters->get_m_theta();
+  }
+  return 1.0-no_mutation;
+}
+
+/**
+ * \brief    Accumulate the statistics over the whole population
+ * \details  Extra pass, only needed when individuals were replaced one by one
+ * \param    void
+ * \return   \e void
+ */
+void Population::accumulate_statistics( void )
+{
+  _accumulator->reset();
+  for (int i = 0; i < _population_size; i++)
+  {
+    _accumulator->add_individual(_pop[i]);
+  }
+  _accumulator_outdated = false;
+}
+
+/**
+ * \brief    Record the death of the previous generation in the lineage tree or log
+ * \details  Called once both buffers swapped roles, the previous generation
+ *           being in the next generation buffer. Dead branches are released
+ *           by the death events. Does nothing if lineages are not tracked
+ * \param    void
+ * \return   \e void
+ */
+void Population::update_tree( void )
+{
+  if (_tree == NULL && _lineage_log == NULL)
+  {
+    return;
+  }
+  for (int i = 0; i < _population_size; i++)
+  {
+    record_death(_next_pop[i]);
+  }
+  update_focal_sample();
+}
+
+/**
+ * \brief    Draw the focal sample of the current generation
+ * \details  The focal individuals are the tracked offspring of the previous
+ *           focal sample, so that the sample stays connected through the
+ *           parent indices of the reproduction draw. Beyond
+ *           FOCAL_SAMPLE_GROWTH*k individuals, a uniform subset is kept and
+ *           the others are released from the lineages. The sample is never
+ *           completed by untracked individuals, which would be new roots and
+ *           reset the MRCA: only when no focal individual is left, k
+ *           individuals drawn uniformly restart the sample. The margin above k
+ *           delays this loss, whose expected time grows with k. Draws come
+ *           from a separate stream, so the population does not depend on the
+ *           sampling. Does nothing without a focal sample
+ * \param    void
+ * \return   \e void
+ */
+void Population::update_focal_sample( void )
+{
+  if (_focal_sample_size == 0)
+  {
+    return;
+  }
+  int N        = _population_size;
+  int k        = _focal_sample_size;
+  int capacity = (FOCAL_SAMPLE_GROWTH*k < N ? FOCAL_SAMPLE_GROWTH*k : N);
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 1) Split tracked and untracked        */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  int nb_tracked      = 0;
+  int first_untracked = N;
+  for (int i = 0; i < N; i++)
+  {
+    if (_pop[i]->get_node() != NO_NODE)
+    {
+      _focal_slots[nb_tracked++] = i;
+    }
+    else
+    {
+      _focal_slots[--first_untracked] = i;
+    }
+  }
+  assert(nb_tracked == first_untracked);
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 2) Release the extra individuals      */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* A partial Fisher-Yates shuffle moves the kept individuals first */
+  if (nb_tracked > capacity)
+  {
+    for (int j = 0; j < capacity; j++)
+    {
+      int r           = _focal_prng->uniform(j, nb_tracked-1);
+      int tmp         = _focal_slots[j];
+      _focal_slots[j] = _focal_slots[r];
+      _focal_slots[r] = tmp;
+    }
+    for (int j = capacity; j < nb_tracked; j++)
+    {
+      record_death(_pop[_focal_slots[j]]);
+    }
+  }
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 3) Restart a lost sample with roots   */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  if (nb_tracked > 0)
+  {
+    return;
+  }
+  for (int j = 0; j < k; j++)
+  {
+    int r           = _focal_prng->uniform(j, N-1);
+    int tmp         = _focal_slots[j];
+    _focal_slots[j] = _focal_slots[r];
+    _focal_slots[r] = tmp;
+    record_root(_pop[_focal_slots[j]]);
+  }
+}
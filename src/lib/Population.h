@@ -40,6 +40,11 @@
 #include "Individual.h"
 #include "Environment.h"
 #include "Tree.h"
+#include "LineageLog.h"
+#include "ThreadPool.h"
+#include "Selection.h"
+#include "FenwickTree.h"
+#include "StatisticsAccumulator.h"
 
 class Population
 {
@@ -50,7 +55,7 @@ public:
    * CONSTRUCTORS
    *----------------------------*/
   Population( void ) = delete;
-  Population( Parameters* parameters, Environment* environment, Tree* tree );
+  Population( Parameters* parameters, Environment* environment, Tree* tree, LineageLog* lineage_log, ThreadPool* thread_pool, Prng* prng, int population_size );
   Population( const Population& population ) = delete;
   
   /*----------------------------
@@ -61,18 +66,25 @@ public:
   /*----------------------------
    * GETTERS
    *----------------------------*/
-  inline int         get_population_size( void ) const;
-  inline Individual* get_individual( int i );
+  inline int                    get_population_size( void ) const;
+  inline Individual*            get_individual( int i );
+  inline StatisticsAccumulator* get_statistics_accumulator( void );
   
   /*----------------------------
    * SETTERS
    *----------------------------*/
   Population& operator=(const Population&) = delete;
   
+  void set_individual( int i, Individual* individual );
+  
   /*----------------------------
    * PUBLIC METHODS
    *----------------------------*/
   void compute_next_generation( int next_generation );
+  bool is_monomorphic( void ) const;
+  int  skip_mutation_free_generations( int remaining_generations );
+  
+  StatisticsAccumulator* compute_monomorphic_statistics( int generation );
   
   /*----------------------------
    * PUBLIC ATTRIBUTES
@@ -83,6 +95,18 @@ protected:
   /*----------------------------
    * PROTECTED METHODS
    *----------------------------*/
+  void create_individuals( void );
+  void compute_keyed_generation( int next_generation );
+  void compute_moran_events( int next_generation );
+  void compute_mutating_generation( int next_generation );
+  double offspring_mutation_probability( void ) const;
+  void compute_offspring( int slot, int next_generation, unsigned int generation_key, unsigned long long int first_identifier, StatisticsAccumulator* accumulator );
+  void accumulate_statistics( void );
+  void update_tree( void );
+  void update_focal_sample( void );
+  inline void record_root( Individual* individual );
+  inline void record_birth( Individual* parent, Individual* child );
+  inline void record_death( Individual* individual );
   
   /*----------------------------
    * PROTECTED ATTRIBUTES
@@ -90,17 +114,54 @@ protected:
   
   /*----------------------------------------------- PARAMETERS */
   
-  Parameters*            _parameters;         /*!< Parameters                     */
-  Prng*                  _prng;               /*!< Pseudorandom numbers generator */
-  Environment*           _environment;        /*!< Environment (fitness optimum)  */
-  Tree*                  _tree;               /*!< Lineage tree                   */
-  unsigned long long int _current_identifier; /*!< Current individual identifier  */
+  Parameters*            _parameters;         /*!< Parameters                       */
+  Prng*                  _prng;               /*!< Pseudorandom numbers generator   */
+  int                    _population_size;    /*!< Population size                  */
+  Environment*           _environment;        /*!< Environment (fitness optimum)    */
+  Tree*                  _tree;               /*!< Lineage tree (NULL if untracked) */
+  LineageLog*            _lineage_log;        /*!< Lineage log (NULL if untracked)  */
+  unsigned long long int _current_identifier; /*!< Current individual identifier    */
   
   /*----------------------------------------------- POPULATION */
   
-  Individual** _pop;   /*!< Population vector               */
-  double*      _w;     /*!< Fitness vector                  */
-  double       _w_sum; /*!< Fitness sum (for normalization) */
+  Individual**  _pop;          /*!< Population vector                              */
+  Individual**  _next_pop;     /*!< Next generation buffer (recycled individuals)  */
+  double*       _w;            /*!< Fitness vector (unnormalized)                  */
+  double        _w_sum;        /*!< Fitness sum                                    */
+  unsigned int* _draws;        /*!< Number of offspring of each parent             */
+  Selection*    _selection;    /*!< Multinomial sampler                            */
+  FenwickTree*  _fitness_tree; /*!< Fitness partial sums (Moran model, else NULL)  */
+  
+  /*----------------------------------------------- FOCAL SAMPLE */
+  
+  int   _focal_sample_size; /*!< Individuals whose lineages are tracked (0 if all)  */
+  Prng* _focal_prng;        /*!< Philox generator of the focal sampling (else NULL) */
+  int*  _focal_slots;       /*!< Tracked, then untracked individuals (else NULL)    */
+  
+  /*----------------------------------------------- MONOMORPHISM */
+  
+  bool                   _mutation_pending;        /*!< The next generation must carry at least one mutation */
+  Prng*                  _monomorphic_prng;        /*!< Philox generator of the skipped phenotypes (else NULL) */
+  StatisticsAccumulator* _monomorphic_accumulator; /*!< Expected statistics of the skipped generations         */
+  
+  /*----------------------------------------------- STATISTICS */
+  
+  StatisticsAccumulator*  _accumulator;          /*!< Statistics of the current generation          */
+  bool                    _accumulator_outdated; /*!< Individuals changed since the last accumulation */
+  StatisticsAccumulator** _chunk_accumulators;   /*!< Statistics of each offspring chunk (threads)  */
+  
+  /*----------------------------------------------- PARALLELISM */
+  
+  ThreadPool*  _thread_pool;       /*!< Thread pool (NULL for the sequential legacy path)   */
+  bool         _keyed_offspring;   /*!< Offspring draw from keyed slot streams              */
+  unsigned int _keyed_generations; /*!< Generations computed with keyed streams (stream key) */
+  Prng**       _slot_prngs;        /*!< Philox generator of each offspring slot             */
+  int*         _parents;           /*!< Parent of each offspring slot                       */
+  
+  /*----------------------------------------------- COMMON RANDOM NUMBERS */
+  
+  bool  _common_random_numbers; /*!< Selection, mutations and phenotypes draw from separate keyed streams */
+  Prng* _selection_prng;        /*!< Philox generator of the selection draws (else NULL)                 */
 };
 
 /*----------------------------
@@ -115,7 +176,7 @@ protected:
  */
 inline int Population::get_population_size( void ) const
 {
-  return _parameters->get_population_size();
+  return _population_size;
 }
 
 /**
@@ -129,9 +190,95 @@ inline Individual* Population::get_individual( int i )
   return _pop[i];
 }
 
+/**
+ * \brief    Get the statistics accumulated over the current generation
+ * \details  Statistics are accumulated while offspring are computed. They
+ *           are only recomputed with an extra pass when individuals were
+ *           replaced one by one (Moran events or migrations)
+ * \param    void
+ * \return   \e StatisticsAccumulator*
+ */
+inline StatisticsAccumulator* Population::get_statistics_accumulator( void )
+{
+  if (_accumulator_outdated)
+  {
+    accumulate_statistics();
+  }
+  return _accumulator;
+}
+
 /*----------------------------
  * SETTERS
  *----------------------------*/
 
+/*----------------------------
+ * PROTECTED METHODS
+ *----------------------------*/
+
+/**
+ * \brief    Record a root in the lineage tree or log
+ * \details  Does nothing if lineages are not tracked
+ * \param    Individual* individual
+ * \return   \e void
+ */
+inline void Population::record_root( Individual* individual )
+{
+  if (_tree != NULL)
+  {
+    _tree->add_root(individual);
+  }
+  else if (_lineage_log != NULL)
+  {
+    _lineage_log->add_root(individual);
+  }
+}
+
+/**
+ * \brief    Record a birth in the lineage tree or log
+ * \details  Does nothing if lineages are not tracked. With a focal sample,
+ *           only the offspring of tracked parents are recorded
+ * \param    Individual* parent
+ * \param    Individual* child
+ * \return   \e void
+ */
+inline void Population::record_birth( Individual* parent, Individual* child )
+{
+  if (_focal_sample_size > 0 && parent->get_node() == NO_NODE)
+  {
+    child->set_node(NO_NODE);
+  }
+  else if (_tree != NULL)
+  {
+    _tree->add_reproduction_event(parent, child);
+  }
+  else if (_lineage_log != NULL)
+  {
+    _lineage_log->add_reproduction_event(parent, child);
+  }
+}
+
+/**
+ * \brief    Record a death in the lineage tree or log
+ * \details  Does nothing if lineages are not tracked, or if the individual is
+ *           out of the focal sample
+ * \param    Individual* individual
+ * \return   \e void
+ */
+inline void Population::record_death( Individual* individual )
+{
+  if (_focal_sample_size > 0 && individual->get_node() == NO_NODE)
+  {
+    return;
+  }
+  if (_tree != NULL)
+  {
+    _tree->add_death_event(individual);
+  }
+  else if (_lineage_log != NULL)
+  {
+    _lineage_log->add_death_event(individual);
+  }
+}
+
 
 #endif /* defined(__SigmaFGM__Population__) */
@@ -28,6 +28,13 @@
  ***********************************************************************/
 
 #include "Prng.h"
+#include "Kernels.h"
+
+/* Mean n*p under which binomial draws are inverted. Above, they are drawn by
+   transformed rejection (BTRS), which needs n*p >= 10 */
+#define BINOMIAL_INVERSION_MEAN 10.0
+
+gaussian_sampler Prng::_gaussian_sampler = ZIGGURAT;
 
 
 /*----------------------------
@@ -42,7 +49,45 @@
  */
 Prng::Prng( void )
 {
-  _prng = gsl_rng_alloc(gsl_rng_mt19937);
+  _prng        = gsl_rng_alloc(gsl_rng_mt19937);
+  _type        = MT19937;
+  _state       = _prng->state;
+  _spare       = 0.0;
+  _has_spare   = false;
+  _buffer      = NULL;
+  _buffer_size = 0;
+}
+
+/**
+ * \brief    Constructor with a given algorithm
+ * \details  The built-in engines are also wrapped as GSL generators sharing
+ *           their state, for the distributions only GSL provides
+ * \param    prng_type type
+ * \return   \e void
+ */
+Prng::Prng( prng_type type )
+{
+  switch (type)
+  {
+    case MT19937:
+      _prng = gsl_rng_alloc(gsl_rng_mt19937);
+      break;
+    case PHILOX:
+      _prng = gsl_rng_alloc(Philox::get_gsl_type());
+      break;
+    case XOSHIRO256PP:
+      _prng = gsl_rng_alloc(Xoshiro::get_gsl_type());
+      break;
+    case PCG64:
+      _prng = gsl_rng_alloc(Pcg::get_gsl_type());
+      break;
+  }
+  _type        = type;
+  _state       = _prng->state;
+  _spare       = 0.0;
+  _has_spare   = false;
+  _buffer      = NULL;
+  _buffer_size = 0;
 }
 
 /**
@@ -53,7 +98,13 @@ Prng::Prng( void )
  */
 Prng::Prng( const Prng& prng )
 {
-  _prng = gsl_rng_clone(prng._prng);
+  _prng        = gsl_rng_clone(prng._prng);
+  _type        = prng._type;
+  _state       = _prng->state;
+  _spare       = prng._spare;
+  _has_spare   = prng._has_spare;
+  _buffer      = NULL;
+  _buffer_size = 0;
 }
 
 /*----------------------------
@@ -69,26 +120,66 @@ Prng::Prng( const Prng& prng )
 Prng::~Prng( void )
 {
   gsl_rng_free(_prng);
+  _state = NULL;
+  delete[] _buffer;
+  _buffer = NULL;
 }
 
 /*----------------------------
- * PUBLIC METHODS
+ * GETTERS
  *----------------------------*/
 
 /**
- * \brief    Returns a random variate from the uniform distribution in [0, 1[
- * \details  --
- * \param    void
- * \return   \e double
+ * \brief    Get the name of a generator algorithm
+ * \details  The name is the one of the -prng option
+ * \param    prng_type type
+ * \return   \e const char*
+ */
+const char* Prng::get_type_name( prng_type type )
+{
+  switch (type)
+  {
+    case MT19937:
+      return "MT19937";
+    case PHILOX:
+      return "PHILOX";
+    case XOSHIRO256PP:
+      return "XOSHIRO";
+    case PCG64:
+      return "PCG";
+  }
+  return "";
+}
+
+/*----------------------------
+ * SETTERS
+ *----------------------------*/
+
+/**
+ * \brief    Position the generator at the start of a keyed stream
+ * \details  Only available for counter-based generators (PHILOX). The stream
+ *           only depends on its identifiers, not on previous draws
+ * \param    unsigned long int seed
+ * \param    unsigned int replicate
+ * \param    unsigned int generation
+ * \param    unsigned int slot
+ * \param    prng_stream stream
+ * \return   \e void
  */
-double Prng::uniform( void )
+void Prng::set_stream( unsigned long int seed, unsigned int replicate, unsigned int generation, unsigned int slot, prng_stream stream )
 {
-  return gsl_ran_flat(_prng, 0.0, 1.0);
+  assert(_type == PHILOX);
+  Philox::set_stream(_state, seed, replicate, generation, slot, stream);
+  _has_spare = false;
 }
 
+/*----------------------------
+ * PUBLIC METHODS
+ *----------------------------*/
+
 /**
  * \brief    Returns a random integer variate from the uniform distribution in [min, max]
- * \details  --
+ * \details  Same transform as gsl_ran_flat()
  * \param    int min
  * \param    int max
  * \return   \e int
@@ -96,12 +187,13 @@ double Prng::uniform( void )
 int Prng::uniform( int min, int max )
 {
   assert(min <= max);
-  return floor(gsl_ran_flat(_prng, (double)min, (double)(max+1)));
+  double u = uniform();
+  return floor((double)min*(1.0-u)+(double)(max+1)*u);
 }
 
 /**
  * \brief    Returns a Bernouilli trial with probability p
- * \details  --
+ * \details  Same test as gsl_ran_bernoulli()
  * \param    double p
  * \return   \e int
  */
@@ -109,12 +201,13 @@ int Prng::bernouilli( double p )
 {
   assert(p >= 0.0);
   assert(p <= 1.0);
-  return gsl_ran_bernoulli(_prng, p);
+  return (uniform() < p ? 1 : 0);
 }
 
 /**
  * \brief    Returns a random integer from the binomial distribution, the number of successes in n independent trials with probability p
- * \details  --
+ * \details  MT19937 keeps the GSL sampler and its draws. The built-in engines
+ *           are drawn by draw_binomial(), without the GSL dispatch
  * \param    size_t n
  * \param    double p
  * \return   \e size_t
@@ -123,7 +216,17 @@ size_t Prng::binomial( size_t n, double p )
 {
   assert(p >= 0.0);
   assert(p <= 1.0);
-  return gsl_ran_binomial(_prng, p, (unsigned int)n);
+  switch (_type)
+  {
+    case PHILOX:
+      return draw_binomial<Philox>((philox_state*)_state, n, p);
+    case XOSHIRO256PP:
+      return draw_binomial<Xoshiro>((xoshiro_state*)_state, n, p);
+    case PCG64:
+      return draw_binomial<Pcg>((pcg_state*)_state, n, p);
+    default:
+      return gsl_ran_binomial(_prng, p, (unsigned int)n);
+  }
 }
 
 /**
@@ -142,7 +245,10 @@ void Prng::multinomial( unsigned int* draws, double* probas, int N, int K )
 
 /**
  * \brief Returns a Gaussian random variate, with mean mu and standard deviation sigma
- * \details  --
+ * \details  MT19937 keeps the GSL ziggurat and its draws. The built-in engines
+ *           use the Box-Muller transform of the numeric kernel: a pair of
+ *           uniforms gives two values, the second one being kept for the
+ *           next call
  * \param    double mu
  * \param    double sigma
  * \return   \e double
@@ -154,7 +260,20 @@ double Prng::gaussian( double mu, double sigma )
   {
     return mu;
   }
-  return mu+gsl_ran_gaussian_ziggurat(_prng, sigma);
+  if (_type == MT19937)
+  {
+    return mu+gsl_ran_gaussian_ziggurat(_prng, sigma);
+  }
+  if (_has_spare)
+  {
+    _has_spare = false;
+    return mu+sigma*_spare;
+  }
+  double r     = sqrt(-2.0*log(1.0-uniform()));
+  double theta = 6.283185307179586476925286766559*uniform();
+  _spare       = r*sin(theta);
+  _has_spare   = true;
+  return mu+sigma*r*cos(theta);
 }
 
 /**
@@ -179,6 +298,29 @@ int Prng::poisson( double mu )
   return gsl_ran_poisson(_prng, mu);
 }
 
+/**
+ * \brief    Returns the number of failures before the first success of independent trials with probability p
+ * \details  Drawn by inversion, so that very small probabilities (long waiting
+ *           times) are handled exactly. The result is an integer stored as a
+ *           double, to avoid overflows. It is infinite when p is 0
+ * \param    double p
+ * \return   \e double
+ */
+double Prng::geometric( double p )
+{
+  assert(p >= 0.0);
+  assert(p <= 1.0);
+  if (p == 0.0)
+  {
+    return INFINITY;
+  }
+  if (p == 1.0)
+  {
+    return 0.0;
+  }
+  return floor(log(1.0-uniform())/log1p(-p));
+}
+
 /**
  * \brief    Returns the selected index after a roulette wheel selection
  * \details  --
@@ -215,6 +357,251 @@ void Prng::shuffle( void* base, size_t n, size_t size )
   gsl_ran_shuffle(_prng, base, n, size);
 }
 
+/**
+ * \brief    Fill a block with uniform draws in [0,1)
+ * \details  Blocks of the built-in engines are generated without the GSL
+ *           dispatch
+ * \param    double* x
+ * \param    int n
+ * \return   \e void
+ */
+void Prng::uniform_block( double* x, int n )
+{
+  switch (_type)
+  {
+    case PHILOX:
+      Philox::fill_uniform((philox_state*)_state, x, n);
+      break;
+    case XOSHIRO256PP:
+      Xoshiro::fill_uniform((xoshiro_state*)_state, x, n);
+      break;
+    case PCG64:
+      Pcg::fill_uniform((pcg_state*)_state, x, n);
+      break;
+    default:
+      for (int i = 0; i < n; i++)
+      {
+        x[i] = gsl_rng_uniform(_prng);
+      }
+      break;
+  }
+}
+
+/**
+ * \brief    Fill a block with N(0,1) draws
+ * \details  The built-in engines transform a block of uniforms with the
+ *           vectorized Box-Muller kernel. MT19937 does so with BOX_MULLER, and
+ *           keeps the draws of gaussian(0.0, 1.0) with ZIGGURAT (default)
+ * \param    double* x
+ * \param    int n
+ * \return   \e void
+ */
+void Prng::gaussian_block( double* x, int n )
+{
+  if (_type != MT19937 || _gaussian_sampler == BOX_MULLER)
+  {
+    double* uniform = get_buffer(n+n%2);
+    uniform_block(uniform, n+n%2);
+    Kernels::box_muller(x, uniform, n);
+    return;
+  }
+  for (int i = 0; i < n; i++)
+  {
+    x[i] = gsl_ran_gaussian_ziggurat(_prng, 1.0);
+  }
+}
+
+/**
+ * \brief    Fill a block with N(mu, sigma^2) draws
+ * \details  See gaussian_block(double* x, int n)
+ * \param    double* x
+ * \param    int n
+ * \param    double mu
+ * \param    double sigma
+ * \return   \e void
+ */
+void Prng::gaussian_block( double* x, int n, double mu, double sigma )
+{
+  assert(sigma >= 0.0);
+  if (sigma <= 0.0)
+  {
+    for (int i = 0; i < n; i++)
+    {
+      x[i] = mu;
+    }
+  }
+  else if (_type != MT19937 || _gaussian_sampler == BOX_MULLER)
+  {
+    gaussian_block(x, n);
+    for (int i = 0; i < n; i++)
+    {
+      x[i] = mu+sigma*x[i];
+    }
+  }
+  else
+  {
+    for (int i = 0; i < n; i++)
+    {
+      x[i] = mu+gsl_ran_gaussian_ziggurat(_prng, sigma);
+    }
+  }
+}
+
+/**
+ * \brief    Draw a seed for a substream
+ * \details  --
+ * \param    void
+ * \return   \e unsigned long int
+ */
+unsigned long int Prng::draw_seed( void )
+{
+  return gsl_rng_get(_prng);
+}
+
+/**
+ * \brief    Compute the seed of substream index from a seed
+ * \details  Mixes both values with the splitmix64 finalizer, so that close
+ *           indices give unrelated seeds
+ * \param    unsigned long int seed
+ * \param    unsigned long int index
+ * \return   \e unsigned long int
+ */
+unsigned long int Prng::substream_seed( unsigned long int seed, unsigned long int index )
+{
+  unsigned long long int z = (unsigned long long int)seed+0x9E3779B97F4A7C15ULL*((unsigned long long int)index+1ULL);
+  z = (z^(z >> 30))*0xBF58476D1CE4E5B9ULL;
+  z = (z^(z >> 27))*0x94D049BB133111EBULL;
+  return (unsigned long int)(z^(z >> 31));
+}
+
 /*----------------------------
  * PROTECTED METHODS
  *----------------------------*/
+
+/**
+ * \brief    Get a buffer of at least n doubles
+ * \details  The buffer only grows, so blocks of a steady size never allocate
+ * \param    int n
+ * \return   \e double*
+ */
+double* Prng::get_buffer( int n )
+{
+  if (n > _buffer_size)
+  {
+    delete[] _buffer;
+    _buffer      = new double[n];
+    _buffer_size = n;
+  }
+  return _buffer;
+}
+
+/**
+ * \brief    Draw a binomial variate from an engine
+ * \details  Draws n-B(n, 1-p) when p > 1/2. Small means are inverted by
+ *           sequential search from 0 (as numpy). Larger ones are drawn by
+ *           the transformed rejection with squeeze of Hormann (1993, BTRS),
+ *           which takes about two uniforms per draw whatever n
+ * \param    State* state
+ * \param    size_t n
+ * \param    double p
+ * \return   \e size_t
+ */
+template <typename Engine, typename State>
+size_t Prng::draw_binomial( State* state, size_t n, double p )
+{
+  if (p > 0.5)
+  {
+    return n-draw_binomial<Engine>(state, n, 1.0-p);
+  }
+  if (n == 0 || p == 0.0)
+  {
+    return 0;
+  }
+  double q = 1.0-p;
+  double N = (double)n;
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 1) Inversion for small means          */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  if (N*p < BINOMIAL_INVERSION_MEAN)
+  {
+    double qn    = exp(N*log1p(-p));
+    double bound = fmin(N, N*p+10.0*sqrt(N*p*q+1.0));
+    double x     = 0.0;
+    double px    = qn;
+    double u     = Engine::uniform(state);
+    while (u > px)
+    {
+      x++;
+      if (x > bound)
+      {
+        x  = 0.0;
+        px = qn;
+        u  = Engine::uniform(state);
+      }
+      else
+      {
+        u  -= px;
+        px *= (N-x+1.0)*p/(x*q);
+      }
+    }
+    return (size_t)x;
+  }
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 2) Transformed rejection (BTRS)       */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  double sd    = sqrt(N*p*q);
+  double b     = 1.15+2.53*sd;
+  double a     = -0.0873+0.0248*b+0.01*p;
+  double c     = N*p+0.5;
+  double v_r   = 0.92-4.2/b;
+  double r     = p/q;
+  double alpha = (2.83+5.1/b)*sd;
+  double m     = floor((N+1.0)*p);
+  while (true)
+  {
+    double u  = Engine::uniform(state)-0.5;
+    double v  = Engine::uniform(state);
+    double us = 0.5-fabs(u);
+    double k  = floor((2.0*a/us+b)*u+c);
+    if (k < 0.0 || k > N)
+    {
+      continue;
+    }
+    if (us >= 0.07 && v <= v_r)
+    {
+      return (size_t)k;
+    }
+    v            = log(v*alpha/(a/(us*us)+b));
+    double bound = (m+0.5)*log((m+1.0)/(r*(N-m+1.0)))
+                  +(N+1.0)*log((N-m+1.0)/(N-k+1.0))
+                  +(k+0.5)*log(r*(N-k+1.0)/(k+1.0))
+                  +stirling_tail(m)+stirling_tail(N-m)-stirling_tail(k)-stirling_tail(N-k);
+    if (v <= bound)
+    {
+      return (size_t)k;
+    }
+  }
+}
+
+/**
+ * \brief    Tail of the Stirling series of log(k!)
+ * \details  log(k!)-[(k+1/2)log(k+1)-(k+1)+log(2pi)/2], tabulated up to 9
+ * \param    double k
+ * \return   \e double
+ */
+double Prng::stirling_tail( double k )
+{
+  static const double table[10] =
+  {
+    0.0810614667953272, 0.0413406959554092, 0.0276779256849983, 0.02079067210376509, 0.0166446911898211,
+    0.0138761288230707, 0.0118967099458917, 0.0104112652619720, 0.00925546218271273, 0.00833056343336287
+  };
+  if (k <= 9.0)
+  {
+    return table[(int)k];
+  }
+  double k1 = (k+1.0)*(k+1.0);
+  return (1.0/12.0-(1.0/360.0-1.0/1260.0/k1)/k1)/(k+1.0);
+}
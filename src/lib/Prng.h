@@ -36,6 +36,11 @@
 #include <cmath>
 #include <assert.h>
 
+#include "Enums.h"
+#include "Philox.h"
+#include "Xoshiro.h"
+#include "Pcg.h"
+
 
 class Prng
 {
@@ -46,6 +51,7 @@ public:
    * CONSTRUCTORS
    *----------------------------*/
   Prng( void );
+  Prng( prng_type type );
   Prng( const Prng& prng );
   
   /*----------------------------
@@ -56,17 +62,21 @@ public:
   /*----------------------------
    * GETTERS
    *----------------------------*/
+  static inline gaussian_sampler get_gaussian_sampler( void );
+  static const char*             get_type_name( prng_type type );
   
   /*----------------------------
    * SETTERS
    *----------------------------*/
   Prng& operator=(const Prng&) = delete;
-  inline void set_seed( unsigned long int seed );
+  static inline void set_gaussian_sampler( gaussian_sampler sampler );
+  inline void        set_seed( unsigned long int seed );
+  void        set_stream( unsigned long int seed, unsigned int replicate, unsigned int generation, unsigned int slot, prng_stream stream );
   
   /*----------------------------
    * PUBLIC METHODS
    *----------------------------*/
-  double uniform( void );
+  inline double uniform( void );
   int    uniform( int min, int max );
   int    bernouilli( double p );
   size_t binomial( size_t n, double p );
@@ -74,8 +84,15 @@ public:
   double gaussian( double mu, double sigma );
   int    exponential( double mu );
   int    poisson( double mu );
+  double geometric( double p );
   int    roulette_wheel( double* probas, double sum, int N );
   void   shuffle( void* base, size_t n, size_t size );
+  void   uniform_block( double* x, int n );
+  void   gaussian_block( double* x, int n );
+  void   gaussian_block( double* x, int n, double mu, double sigma );
+  
+  unsigned long int        draw_seed( void );
+  static unsigned long int substream_seed( unsigned long int seed, unsigned long int index );
   
   /*----------------------------
    * PUBLIC ATTRIBUTES
@@ -86,11 +103,24 @@ protected:
   /*----------------------------
    * PROTECTED METHODS
    *----------------------------*/
+  double* get_buffer( int n );
+  
+  template <typename Engine, typename State>
+  static size_t draw_binomial( State* state, size_t n, double p );
+  static double stirling_tail( double k );
   
   /*----------------------------
    * PROTECTED ATTRIBUTES
    *----------------------------*/
-  gsl_rng* _prng; /*!< Pseudorandom numbers generator */
+  gsl_rng*  _prng;        /*!< GSL generator (gsl-only distributions)         */
+  prng_type _type;        /*!< Algorithm of the generator                     */
+  void*     _state;       /*!< Engine state, shared with the GSL generator    */
+  double    _spare;       /*!< Second value of the last Box-Muller pair       */
+  bool      _has_spare;   /*!< Indicates if the spare value is still unused   */
+  double*   _buffer;      /*!< Uniform draws of the block methods             */
+  int       _buffer_size; /*!< Size of the buffer                             */
+  
+  static gaussian_sampler _gaussian_sampler; /*!< Sampler of the MT19937 gaussian blocks */
   
 };
 
@@ -99,10 +129,33 @@ protected:
  * GETTERS
  *----------------------------*/
 
+/**
+ * \brief    Get the sampler of the gaussian blocks
+ * \details  --
+ * \param    void
+ * \return   \e gaussian_sampler
+ */
+inline gaussian_sampler Prng::get_gaussian_sampler( void )
+{
+  return _gaussian_sampler;
+}
+
 /*----------------------------
  * SETTERS
  *----------------------------*/
 
+/**
+ * \brief    Set the sampler of the gaussian blocks (for all generators)
+ * \details  Only MT19937 generators use it, the other engines always
+ *           transform blocks of uniforms with the numeric kernel
+ * \param    gaussian_sampler sampler
+ * \return   \e void
+ */
+inline void Prng::set_gaussian_sampler( gaussian_sampler sampler )
+{
+  _gaussian_sampler = sampler;
+}
+
 /**
  * \brief    Set prng seed
  * \details  --
@@ -112,6 +165,33 @@ protected:
 inline void Prng::set_seed( unsigned long int seed )
 {
   gsl_rng_set(_prng, seed);
+  _has_spare = false;
+}
+
+/*----------------------------
+ * PUBLIC METHODS
+ *----------------------------*/
+
+/**
+ * \brief    Returns a random variate from the uniform distribution in [0, 1[
+ * \details  The built-in engines are called directly, only MT19937 goes
+ *           through the GSL dispatch
+ * \param    void
+ * \return   \e double
+ */
+inline double Prng::uniform( void )
+{
+  switch (_type)
+  {
+    case PHILOX:
+      return Philox::uniform((philox_state*)_state);
+    case XOSHIRO256PP:
+      return Xoshiro::uniform((xoshiro_state*)_state);
+    case PCG64:
+      return Pcg::uniform((pcg_state*)_state);
+    default:
+      return gsl_rng_uniform(_prng);
+  }
 }
 
 
@@ -0,0 +1,608 @@
+
+/**
+ * \file      ScalarPopulation.cpp
+ * \authors   Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * \date      18-10-2026
+ * \copyright Copyright (C) 2016-2020 Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard. All rights reserved
+ * \license   This project is released under the GNU General Public License
+ * \brief     ScalarPopulation class definition
+ */
+
+/***********************************************************************
+ * Copyright (C) 2016-2020
+ * Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * Web: https://github.com/charlesrocabert/SigmaFGM/
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#include "ScalarPopulation.h"
+
+/* Number of individuals computed by a task on the threads. Each replicate of
+   a chunk is evaluated on stack copies of this size */
+#define SCALAR_CHUNK_SIZE 256
+
+
+/*----------------------------
+ * CONSTRUCTORS
+ *----------------------------*/
+
+/**
+ * \brief    Constructor
+ * \details  One-dimensional population engine. Genotypes and phenotypes are
+ *           stored as contiguous arrays, and each step of the life cycle is
+ *           applied to the whole population at once. K replicates differing
+ *           only by their prng stream are run in lockstep. With MT19937,
+ *           replicate k uses the seed (seed+k) and reproduces the single run
+ *           with this seed. With PHILOX, it uses the keyed stream of replicate
+ *           k, which never overlaps the streams of the other replicates. With
+ *           a thread pool, mutations and phenotypes are drawn from Philox
+ *           streams keyed by replicate, generation and slot, and chunks of
+ *           individuals are computed on the threads (see compute_chunk())
+ * \param    Parameters* parameters
+ * \param    Environment* environment
+ * \param    ThreadPool* thread_pool
+ * \return   \e void
+ */
+ScalarPopulation::ScalarPopulation( Parameters* parameters, Environment* environment, ThreadPool* thread_pool )
+{
+  assert(parameters != NULL);
+  assert(environment != NULL);
+  assert(parameters->get_number_of_dimensions() == 1);
+  
+  /*----------------------------------------------- PARAMETERS */
+  
+  _parameters  = parameters;
+  _environment = environment;
+  _N           = _parameters->get_population_size();
+  _K           = _parameters->get_number_of_replicates();
+  _noise_type  = _parameters->get_noise_type();
+  _prngs       = new Prng*[_K];
+  _prngs[0]    = _parameters->get_prng();
+  for (int k = 1; k < _K; k++)
+  {
+    _prngs[k] = new Prng(_parameters->get_prng_type());
+    if (_parameters->get_prng_type() == PHILOX)
+    {
+      _prngs[k]->set_stream(_parameters->get_seed(), (unsigned int)k, 0, 0, MAIN_STREAM);
+    }
+    else
+    {
+      _prngs[k]->set_seed(_parameters->get_seed()+(unsigned long int)k);
+    }
+  }
+  
+  /*----------------------------------------------- PARALLELISM */
+  
+  _thread_pool       = thread_pool;
+  _keyed_generations = 0;
+  _nb_chunks         = (_N+SCALAR_CHUNK_SIZE-1)/SCALAR_CHUNK_SIZE;
+  _chunk_prngs       = NULL;
+  if (_thread_pool != NULL)
+  {
+    _chunk_prngs = new Prng*[_nb_chunks];
+    for (int chunk = 0; chunk < _nb_chunks; chunk++)
+    {
+      _chunk_prngs[chunk] = new Prng(PHILOX);
+    }
+  }
+  
+  /*----------------------------------------------- GENOTYPES */
+  
+  _mu         = Memory::allocate_doubles((size_t)_N*_K);
+  _sigma      = Memory::allocate_doubles((size_t)_N*_K);
+  _next_mu    = Memory::allocate_doubles((size_t)_N*_K);
+  _next_sigma = Memory::allocate_doubles((size_t)_N*_K);
+  
+  /*----------------------------------------------- PHENOTYPES */
+  
+  _gaussian      = Memory::allocate_doubles((size_t)_N*_K);
+  _lane_gaussian = Memory::allocate_doubles((size_t)_N);
+  _z             = Memory::allocate_doubles((size_t)_N*_K);
+  _dmu           = Memory::allocate_doubles((size_t)_N*_K);
+  _dz            = Memory::allocate_doubles((size_t)_N*_K);
+  _Wmu           = Memory::allocate_doubles((size_t)_N*_K);
+  _Wz            = Memory::allocate_doubles((size_t)_N*_K);
+  _sum_Wmu       = Memory::allocate_doubles((size_t)_N*_K);
+  _sum_Wz        = Memory::allocate_doubles((size_t)_N*_K);
+  
+  /*----------------------------------------------- MAPPING PROPERTIES */
+  
+  _max_Sigma_eigenvalue   = Memory::allocate_doubles((size_t)_N*_K);
+  _max_Sigma_contribution = Memory::allocate_doubles((size_t)_N*_K);
+  _max_dot_product        = Memory::allocate_doubles((size_t)_N*_K);
+  
+  /*----------------------------------------------- MUTATIONS */
+  
+  _r_mu    = Memory::allocate_doubles((size_t)_N*_K);
+  _r_sigma = Memory::allocate_doubles((size_t)_N*_K);
+  
+  /*----------------------------------------------- SELECTION */
+  
+  _w         = new double[_N];
+  _draws     = new unsigned int[_N*_K];
+  _selection = new Selection(_parameters->get_selection_sampler(), _N, _thread_pool);
+  
+  /*----------------------------------------------- INITIAL POPULATION */
+  
+  /* With a thread pool, each shard of the arrays is first touched by the */
+  /* thread which computes it in every generation (see run_sharded())     */
+  if (_thread_pool != NULL)
+  {
+    _thread_pool->run_sharded(_nb_chunks, [&]( int chunk )
+    {
+      int first = chunk*SCALAR_CHUNK_SIZE;
+      initialize(first, (first+SCALAR_CHUNK_SIZE < _N ? first+SCALAR_CHUNK_SIZE : _N));
+      compute_chunk(chunk, 0, true);
+    });
+    return;
+  }
+  initialize(0, _N);
+  compute_mapping_properties(0, _N);
+  build_phenotypes();
+  if (!_parameters->get_mean_fitness())
+  {
+    compute_fitness();
+  }
+  else
+  {
+    compute_mean_fitness();
+  }
+}
+
+/*----------------------------
+ * DESTRUCTORS
+ *----------------------------*/
+
+/**
+ * \brief    Destructor
+ * \details  --
+ * \param    void
+ * \return   \e void
+ */
+ScalarPopulation::~ScalarPopulation( void )
+{
+  _parameters  = NULL;
+  _environment = NULL;
+  _prngs[0]    = NULL;
+  for (int k = 1; k < _K; k++)
+  {
+    delete _prngs[k];
+    _prngs[k] = NULL;
+  }
+  delete[] _prngs;
+  _prngs       = NULL;
+  _thread_pool = NULL;
+  if (_chunk_prngs != NULL)
+  {
+    for (int chunk = 0; chunk < _nb_chunks; chunk++)
+    {
+      delete _chunk_prngs[chunk];
+      _chunk_prngs[chunk] = NULL;
+    }
+    delete[] _chunk_prngs;
+    _chunk_prngs = NULL;
+  }
+  Memory::release_doubles(_mu, (size_t)_N*_K);
+  _mu = NULL;
+  Memory::release_doubles(_sigma, (size_t)_N*_K);
+  _sigma = NULL;
+  Memory::release_doubles(_next_mu, (size_t)_N*_K);
+  _next_mu = NULL;
+  Memory::release_doubles(_next_sigma, (size_t)_N*_K);
+  _next_sigma = NULL;
+  Memory::release_doubles(_gaussian, (size_t)_N*_K);
+  _gaussian = NULL;
+  Memory::release_doubles(_lane_gaussian, (size_t)_N);
+  _lane_gaussian = NULL;
+  Memory::release_doubles(_z, (size_t)_N*_K);
+  _z = NULL;
+  Memory::release_doubles(_dmu, (size_t)_N*_K);
+  _dmu = NULL;
+  Memory::release_doubles(_dz, (size_t)_N*_K);
+  _dz = NULL;
+  Memory::release_doubles(_Wmu, (size_t)_N*_K);
+  _Wmu = NULL;
+  Memory::release_doubles(_Wz, (size_t)_N*_K);
+  _Wz = NULL;
+  Memory::release_doubles(_sum_Wmu, (size_t)_N*_K);
+  _sum_Wmu = NULL;
+  Memory::release_doubles(_sum_Wz, (size_t)_N*_K);
+  _sum_Wz = NULL;
+  Memory::release_doubles(_max_Sigma_eigenvalue, (size_t)_N*_K);
+  _max_Sigma_eigenvalue = NULL;
+  Memory::release_doubles(_max_Sigma_contribution, (size_t)_N*_K);
+  _max_Sigma_contribution = NULL;
+  Memory::release_doubles(_max_dot_product, (size_t)_N*_K);
+  _max_dot_product = NULL;
+  Memory::release_doubles(_r_mu, (size_t)_N*_K);
+  _r_mu = NULL;
+  Memory::release_doubles(_r_sigma, (size_t)_N*_K);
+  _r_sigma = NULL;
+  delete[] _w;
+  _w = NULL;
+  delete[] _draws;
+  _draws = NULL;
+  delete _selection;
+  _selection = NULL;
+}
+
+/*----------------------------
+ * PUBLIC METHODS
+ *----------------------------*/
+
+/**
+ * \brief    Compute the next generation
+ * \details  Selection and the copy of the parental genotypes are sequential.
+ *           With a thread pool, the offspring are then mutated and evaluated
+ *           by chunks on the threads
+ * \param    int next_generation
+ * \return   \e void
+ */
+void ScalarPopulation::compute_next_generation( int next_generation )
+{
+  (void)next_generation;
+  
+  for (int k = 0; k < _K; k++)
+  {
+    /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+    /* 1) Draw the number of offspring       */
+    /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+    unsigned int* draws = &_draws[k*_N];
+    for (int i = 0; i < _N; i++)
+    {
+      _w[i] = _Wz[i*_K+k];
+    }
+    double w_sum = Kernels::sum(_w, _N);
+    _selection->draw(_prngs[k], _w, w_sum, draws);
+    
+    /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+    /* 2) Copy parental genotypes            */
+    /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+    int new_index = 0;
+    for (int i = 0; i < _N; i++)
+    {
+      for (unsigned int j = 0; j < draws[i]; j++)
+      {
+        _next_mu[new_index*_K+k]    = _mu[i*_K+k];
+        _next_sigma[new_index*_K+k] = _sigma[i*_K+k];
+        new_index++;
+      }
+    }
+    assert(new_index == _N);
+  }
+  double* tmp = _mu;
+  _mu         = _next_mu;
+  _next_mu    = tmp;
+  tmp         = _sigma;
+  _sigma      = _next_sigma;
+  _next_sigma = tmp;
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 3) Mutate, build and evaluate         */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  if (_thread_pool != NULL)
+  {
+    unsigned int generation_key = _keyed_generations++;
+    _thread_pool->run_sharded(_nb_chunks, [&]( int chunk )
+    {
+      compute_chunk(chunk, generation_key, false);
+    });
+    return;
+  }
+  mutate();
+  compute_mapping_properties(0, _N);
+  build_phenotypes();
+  if (!_parameters->get_mean_fitness())
+  {
+    compute_fitness();
+  }
+  else
+  {
+    compute_mean_fitness();
+  }
+}
+
+/*----------------------------
+ * PROTECTED METHODS
+ *----------------------------*/
+
+/**
+ * \brief    Initialize individuals first to last (excluded) in all replicates
+ * \details  Every array is written, so that its pages are first touched by
+ *           the calling thread
+ * \param    int first
+ * \param    int last
+ * \return   \e void
+ */
+void ScalarPopulation::initialize( int first, int last )
+{
+  double sigma_init = (_noise_type != NONE ? _parameters->get_initial_sigma() : 0.0);
+  for (int i = first*_K; i < last*_K; i++)
+  {
+    _mu[i]                     = _parameters->get_initial_mu();
+    _sigma[i]                  = sigma_init;
+    _next_mu[i]                = 0.0;
+    _next_sigma[i]             = 0.0;
+    _gaussian[i]               = 0.0;
+    _z[i]                      = 0.0;
+    _dmu[i]                    = 0.0;
+    _dz[i]                     = 0.0;
+    _Wmu[i]                    = 0.0;
+    _Wz[i]                     = 0.0;
+    _sum_Wmu[i]                = 0.0;
+    _sum_Wz[i]                 = 0.0;
+    _max_Sigma_eigenvalue[i]   = 0.0;
+    _max_Sigma_contribution[i] = 0.0;
+    _max_dot_product[i]        = 0.0;
+    _r_mu[i]                   = 0.0;
+    _r_sigma[i]                = 0.0;
+  }
+  for (int i = first; i < last; i++)
+  {
+    _lane_gaussian[i] = 0.0;
+  }
+}
+
+/**
+ * \brief    Mutate the genotypes
+ * \details  Sequential pass: each replicate draws from its own generator,
+ *           individual after individual
+ * \param    void
+ * \return   \e void
+ */
+void ScalarPopulation::mutate( void )
+{
+  for (int i = 0; i < _N*_K; i++)
+  {
+    mutate_genotype(i, _prngs[i%_K]);
+  }
+}
+
+/**
+ * \brief    Mutate one genotype
+ * \details  Draws random numbers in the same order as Individual::mutate()
+ * \param    int index
+ * \param    Prng* prng
+ * \return   \e void
+ */
+void ScalarPopulation::mutate_genotype( int index, Prng* prng )
+{
+  _r_mu[index]    = 0.0;
+  _r_sigma[index] = 0.0;
+  if (prng->uniform() < _parameters->get_m_mu())
+  {
+    double previous_mu = _mu[index];
+    _mu[index]        += prng->gaussian(0.0, _parameters->get_s_mu());
+    _r_mu[index]       = fabs(_mu[index]-previous_mu);
+  }
+  if (_noise_type != NONE && prng->uniform() < _parameters->get_m_sigma())
+  {
+    double previous_sigma = _sigma[index];
+    _sigma[index]         = fabs(_sigma[index]+prng->gaussian(0.0, _parameters->get_s_sigma()));
+    _r_sigma[index]       = fabs(_sigma[index]-previous_sigma);
+  }
+}
+
+/**
+ * \brief    Draw the phenotypes z in N(mu, sigma^2)
+ * \details  In one dimension the Cholesky factor of Sigma is sigma itself
+ * \param    void
+ * \return   \e void
+ */
+void ScalarPopulation::build_phenotypes( void )
+{
+  if (_noise_type == NONE)
+  {
+    for (int i = 0; i < _N*_K; i++)
+    {
+      _z[i] = _mu[i];
+    }
+  }
+  else
+  {
+    if (_K == 1)
+    {
+      _prngs[0]->gaussian_block(_gaussian, _N);
+    }
+    else
+    {
+      /*** Each lane draws its block, then the block is interleaved ***/
+      for (int k = 0; k < _K; k++)
+      {
+        _prngs[k]->gaussian_block(_lane_gaussian, _N);
+        for (int i = 0; i < _N; i++)
+        {
+          _gaussian[i*_K+k] = _lane_gaussian[i];
+        }
+      }
+    }
+    Kernels::phenotype(_z, _mu, _sigma, _gaussian, _N*_K);
+  }
+}
+
+/**
+ * \brief    Compute the fitness
+ * \details  --
+ * \param    void
+ * \return   \e void
+ */
+void ScalarPopulation::compute_fitness( void )
+{
+  double alpha = _parameters->get_alpha();
+  double beta  = _parameters->get_beta();
+  double Q     = _parameters->get_Q();
+  double z_opt = _environment->get_z_opt(0);
+  Kernels::distance(_dmu, _mu, z_opt, _N*_K);
+  Kernels::distance(_dz, _z, z_opt, _N*_K);
+  Kernels::fitness(_Wmu, _dmu, alpha, beta, Q, _N*_K);
+  Kernels::fitness(_Wz, _dz, alpha, beta, Q, _N*_K);
+}
+
+/**
+ * \brief    Compute the mean fitness
+ * \details  The fitness is averaged over 1000 phenotype draws, as in
+ *           Individual::compute_mean_fitness()
+ * \param    void
+ * \return   \e void
+ */
+void ScalarPopulation::compute_mean_fitness( void )
+{
+  for (int i = 0; i < _N*_K; i++)
+  {
+    _sum_Wmu[i] = 0.0;
+    _sum_Wz[i]  = 0.0;
+  }
+  for (int k = 0; k < 1000; k++)
+  {
+    build_phenotypes();
+    compute_fitness();
+    for (int i = 0; i < _N*_K; i++)
+    {
+      _sum_Wmu[i] += _Wmu[i];
+      _sum_Wz[i]  += _Wz[i];
+    }
+  }
+  for (int i = 0; i < _N*_K; i++)
+  {
+    _Wmu[i] = _sum_Wmu[i]/1000.0;
+    _Wz[i]  = _sum_Wz[i]/1000.0;
+  }
+}
+
+/**
+ * \brief    Compute the properties of the phenotypic noise
+ * \details  Follows Individual::build_Sigma() and Individual::compute_dot_product()
+ *           for n = 1: the only eigen vector is (1), so the dot product with the
+ *           normalized optimum direction is 1 (undefined on the optimum).
+ *           Individuals first to last (excluded) are updated in all replicates
+ * \param    int first
+ * \param    int last
+ * \return   \e void
+ */
+void ScalarPopulation::compute_mapping_properties( int first, int last )
+{
+  if (_noise_type == NONE)
+  {
+    return;
+  }
+  double z_opt = _environment->get_z_opt(0);
+  for (int i = first*_K; i < last*_K; i++)
+  {
+    double EV                  = _sigma[i]*_sigma[i];
+    double d                   = z_opt-_mu[i];
+    _max_Sigma_eigenvalue[i]   = EV;
+    _max_Sigma_contribution[i] = EV/EV;
+    _max_dot_product[i]        = fabs(d/fabs(d));
+  }
+}
+
+/**
+ * \brief    Mutate and evaluate a chunk of individuals from keyed streams
+ * \details  The mutations of individual i in replicate k are drawn from the
+ *           keyed stream of slot i, and the phenotypes of replicate k from the
+ *           stream of the first slot of the chunk. A chunk only depends on
+ *           its identifiers and touches its own individuals, so chunks can be
+ *           computed concurrently and the results do not depend on the number
+ *           of threads. Each replicate is evaluated on contiguous copies of
+ *           its values, so that mean fitness draws continue the same stream.
+ *           The initial chunk is not mutated
+ * \param    int chunk
+ * \param    unsigned int generation_key
+ * \param    bool initial
+ * \return   \e void
+ */
+void ScalarPopulation::compute_chunk( int chunk, unsigned int generation_key, bool initial )
+{
+  int               first    = chunk*SCALAR_CHUNK_SIZE;
+  int               last     = (first+SCALAR_CHUNK_SIZE < _N ? first+SCALAR_CHUNK_SIZE : _N);
+  int               n        = last-first;
+  Prng*             prng     = _chunk_prngs[chunk];
+  unsigned long int seed     = _parameters->get_seed();
+  double            alpha    = _parameters->get_alpha();
+  double            beta     = _parameters->get_beta();
+  double            Q        = _parameters->get_Q();
+  double            z_opt    = _environment->get_z_opt(0);
+  int               nb_draws = (_parameters->get_mean_fitness() && _noise_type != NONE ? 1000 : 1);
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 1) Mutate the genotypes               */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  if (!initial)
+  {
+    for (int i = first; i < last; i++)
+    {
+      for (int k = 0; k < _K; k++)
+      {
+        prng->set_stream(seed, (unsigned int)k, generation_key, (unsigned int)i, MUTATION_STREAM);
+        mutate_genotype(i*_K+k, prng);
+      }
+    }
+  }
+  compute_mapping_properties(first, last);
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 2) Evaluate mu                        */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  Kernels::distance(&_dmu[first*_K], &_mu[first*_K], z_opt, n*_K);
+  Kernels::fitness(&_Wmu[first*_K], &_dmu[first*_K], alpha, beta, Q, n*_K);
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 3) Draw and evaluate the phenotypes   */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  double mu[SCALAR_CHUNK_SIZE];
+  double sigma[SCALAR_CHUNK_SIZE];
+  double gaussian[SCALAR_CHUNK_SIZE];
+  double z[SCALAR_CHUNK_SIZE];
+  double dz[SCALAR_CHUNK_SIZE];
+  double Wz[SCALAR_CHUNK_SIZE];
+  double sum_Wz[SCALAR_CHUNK_SIZE];
+  for (int k = 0; k < _K; k++)
+  {
+    for (int j = 0; j < n; j++)
+    {
+      mu[j]     = _mu[(first+j)*_K+k];
+      sigma[j]  = _sigma[(first+j)*_K+k];
+      sum_Wz[j] = 0.0;
+    }
+    prng->set_stream(seed, (unsigned int)k, generation_key, (unsigned int)first, (initial ? INITIAL_STREAM : PHENOTYPE_STREAM));
+    for (int draw = 0; draw < nb_draws; draw++)
+    {
+      if (_noise_type == NONE)
+      {
+        for (int j = 0; j < n; j++)
+        {
+          z[j] = mu[j];
+        }
+      }
+      else
+      {
+        prng->gaussian_block(gaussian, n);
+        Kernels::phenotype(z, mu, sigma, gaussian, n);
+      }
+      Kernels::distance(dz, z, z_opt, n);
+      Kernels::fitness(Wz, dz, alpha, beta, Q, n);
+      for (int j = 0; j < n; j++)
+      {
+        sum_Wz[j] += Wz[j];
+      }
+    }
+    for (int j = 0; j < n; j++)
+    {
+      _z[(first+j)*_K+k]  = z[j];
+      _dz[(first+j)*_K+k] = dz[j];
+      _Wz[(first+j)*_K+k] = sum_Wz[j]/(double)nb_draws;
+    }
+  }
+}
@@ -0,0 +1,379 @@
+
+/**
+ * \file      ScalarPopulation.h
+ * \authors   Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * \date      18-10-2026
+ * \copyright Copyright (C) 2016-2020 Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard. All rights reserved
+ * \license   This project is released under the GNU General Public License
+ * \brief     ScalarPopulation class declaration
+ */
+
+/***********************************************************************
+ * Copyright (C) 2016-2020
+ * Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * Web: https://github.com/charlesrocabert/SigmaFGM/
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#ifndef __SigmaFGM__ScalarPopulation__
+#define __SigmaFGM__ScalarPopulation__
+
+#include <iostream>
+#include <cmath>
+#include <assert.h>
+
+#include "Macros.h"
+#include "Enums.h"
+#include "Prng.h"
+#include "Parameters.h"
+#include "Environment.h"
+#include "Kernels.h"
+#include "Memory.h"
+#include "Selection.h"
+#include "ThreadPool.h"
+
+
+class ScalarPopulation
+{
+  
+public:
+  
+  /*----------------------------
+   * CONSTRUCTORS
+   *----------------------------*/
+  ScalarPopulation( void ) = delete;
+  ScalarPopulation( Parameters* parameters, Environment* environment, ThreadPool* thread_pool );
+  ScalarPopulation( const ScalarPopulation& population ) = delete;
+  
+  /*----------------------------
+   * DESTRUCTORS
+   *----------------------------*/
+  ~ScalarPopulation( void );
+  
+  /*----------------------------
+   * GETTERS
+   *----------------------------*/
+  inline int    get_population_size( void ) const;
+  inline int    get_number_of_replicates( void ) const;
+  inline double get_mu( int i, int replicate ) const;
+  inline double get_sigma( int i, int replicate ) const;
+  inline double get_dmu( int i, int replicate ) const;
+  inline double get_dz( int i, int replicate ) const;
+  inline double get_Wmu( int i, int replicate ) const;
+  inline double get_Wz( int i, int replicate ) const;
+  inline double get_max_Sigma_eigenvalue( int i, int replicate ) const;
+  inline double get_max_Sigma_contribution( int i, int replicate ) const;
+  inline double get_max_dot_product( int i, int replicate ) const;
+  inline double get_r_mu( int i, int replicate ) const;
+  inline double get_r_sigma( int i, int replicate ) const;
+  
+  /*----------------------------
+   * SETTERS
+   *----------------------------*/
+  ScalarPopulation& operator=(const ScalarPopulation&) = delete;
+  
+  /*----------------------------
+   * PUBLIC METHODS
+   *----------------------------*/
+  void compute_next_generation( int next_generation );
+  
+  /*----------------------------
+   * PUBLIC ATTRIBUTES
+   *----------------------------*/
+  
+protected:
+  
+  /*----------------------------
+   * PROTECTED METHODS
+   *----------------------------*/
+  void initialize( int first, int last );
+  void mutate( void );
+  void mutate_genotype( int index, Prng* prng );
+  void build_phenotypes( void );
+  void compute_fitness( void );
+  void compute_mean_fitness( void );
+  void compute_mapping_properties( int first, int last );
+  void compute_chunk( int chunk, unsigned int generation_key, bool initial );
+  
+  /*----------------------------
+   * PROTECTED ATTRIBUTES
+   *----------------------------*/
+  
+  /*----------------------------------------------- PARAMETERS */
+  
+  Parameters*   _parameters;  /*!< Parameters                                    */
+  Prng**        _prngs;       /*!< Pseudorandom numbers generators (one per lane) */
+  Environment*  _environment; /*!< Environment (fitness optimum)                 */
+  int           _N;           /*!< Population size                               */
+  int           _K;           /*!< Number of replicates run in lockstep          */
+  type_of_noise _noise_type;  /*!< Phenotypic noise properties                   */
+  
+  /*----------------------------------------------- PARALLELISM */
+  
+  ThreadPool*  _thread_pool;       /*!< Thread pool (NULL if sequential)          */
+  unsigned int _keyed_generations; /*!< Generations computed from keyed streams   */
+  int          _nb_chunks;         /*!< Number of chunks of individuals           */
+  Prng**       _chunk_prngs;       /*!< Keyed generators of the chunks (threaded) */
+  
+  /*----------------------------------------------- GENOTYPES */
+  
+  /* All the arrays below are interleaved by replicate: the value of     */
+  /* individual i in replicate k is stored at position i*K+k, so that    */
+  /* the K lanes of a given individual are adjacent in memory            */
+  
+  double* _mu;         /*!< mu values                           */
+  double* _sigma;      /*!< sigma values                        */
+  double* _next_mu;    /*!< mu values of the next generation    */
+  double* _next_sigma; /*!< sigma values of the next generation */
+  
+  /*----------------------------------------------- PHENOTYPES */
+  
+  double* _gaussian;      /*!< N(0,1) draws used to build the phenotypes */
+  double* _lane_gaussian; /*!< N(0,1) draws of one replicate             */
+  double* _z;             /*!< Instantaneous phenotypes                  */
+  double* _dmu;           /*!< Euclidean distances d(mu)                 */
+  double* _dz;            /*!< Euclidean distances d(z)                  */
+  double* _Wmu;           /*!< Fitnesses W(mu)                           */
+  double* _Wz;            /*!< Fitnesses W(z)                            */
+  double* _sum_Wmu;       /*!< Fitness W(mu) sums (mean fitness)         */
+  double* _sum_Wz;        /*!< Fitness W(z) sums (mean fitness)          */
+  
+  /*----------------------------------------------- MAPPING PROPERTIES */
+  
+  double* _max_Sigma_eigenvalue;   /*!< Eigen values of Sigma (sigma^2)                  */
+  double* _max_Sigma_contribution; /*!< Eigen value contributions to the total variance */
+  double* _max_dot_product;        /*!< Alignment with the optimum direction            */
+  
+  /*----------------------------------------------- MUTATIONS */
+  
+  double* _r_mu;    /*!< Sizes of mu mutations    */
+  double* _r_sigma; /*!< Sizes of sigma mutations */
+  
+  /*----------------------------------------------- SELECTION */
+  
+  double*       _w;         /*!< Fitness vector of one replicate                 */
+  unsigned int* _draws;     /*!< Number of offspring of each parent, per replicate */
+  Selection*    _selection; /*!< Multinomial sampler                               */
+};
+
+
+/*----------------------------
+ * GETTERS
+ *----------------------------*/
+
+/**
+ * \brief    Get the population size
+ * \details  --
+ * \param    void
+ * \return   \e int
+ */
+inline int ScalarPopulation::get_population_size( void ) const
+{
+  return _N;
+}
+
+/**
+ * \brief    Get the number of replicates run in lockstep
+ * \details  --
+ * \param    void
+ * \return   \e int
+ */
+inline int ScalarPopulation::get_number_of_replicates( void ) const
+{
+  return _K;
+}
+
+/**
+ * \brief    Get mu value of individual i in a replicate
+ * \details  --
+ * \param    int i
+ * \param    int replicate
+ * \return   \e double
+ */
+inline double ScalarPopulation::get_mu( int i, int replicate ) const
+{
+  assert(i >= 0);
+  assert(i < _N);
+  assert(replicate >= 0);
+  assert(replicate < _K);
+  return _mu[i*_K+replicate];
+}
+
+/**
+ * \brief    Get sigma value of individual i in a replicate
+ * \details  Sigma is zero when the noise is disabled
+ * \param    int i
+ * \param    int replicate
+ * \return   \e double
+ */
+inline double ScalarPopulation::get_sigma( int i, int replicate ) const
+{
+  assert(i >= 0);
+  assert(i < _N);
+  assert(replicate >= 0);
+  assert(replicate < _K);
+  return _sigma[i*_K+replicate];
+}
+
+/**
+ * \brief    Get the euclidean distance d(mu) of individual i in a replicate
+ * \details  --
+ * \param    int i
+ * \param    int replicate
+ * \return   \e double
+ */
+inline double ScalarPopulation::get_dmu( int i, int replicate ) const
+{
+  assert(i >= 0);
+  assert(i < _N);
+  assert(replicate >= 0);
+  assert(replicate < _K);
+  return _dmu[i*_K+replicate];
+}
+
+/**
+ * \brief    Get the euclidean distance d(z) of individual i in a replicate
+ * \details  --
+ * \param    int i
+ * \param    int replicate
+ * \return   \e double
+ */
+inline double ScalarPopulation::get_dz( int i, int replicate ) const
+{
+  assert(i >= 0);
+  assert(i < _N);
+  assert(replicate >= 0);
+  assert(replicate < _K);
+  return _dz[i*_K+replicate];
+}
+
+/**
+ * \brief    Get the fitness W(mu) of individual i in a replicate
+ * \details  --
+ * \param    int i
+ * \param    int replicate
+ * \return   \e double
+ */
+inline double ScalarPopulation::get_Wmu( int i, int replicate ) const
+{
+  assert(i >= 0);
+  assert(i < _N);
+  assert(replicate >= 0);
+  assert(replicate < _K);
+  return _Wmu[i*_K+replicate];
+}
+
+/**
+ * \brief    Get the fitness W(z) of individual i in a replicate
+ * \details  --
+ * \param    int i
+ * \param    int replicate
+ * \return   \e double
+ */
+inline double ScalarPopulation::get_Wz( int i, int replicate ) const
+{
+  assert(i >= 0);
+  assert(i < _N);
+  assert(replicate >= 0);
+  assert(replicate < _K);
+  return _Wz[i*_K+replicate];
+}
+
+/**
+ * \brief    Get the maximum eigen value of Sigma of individual i in a replicate
+ * \details  --
+ * \param    int i
+ * \param    int replicate
+ * \return   \e double
+ */
+inline double ScalarPopulation::get_max_Sigma_eigenvalue( int i, int replicate ) const
+{
+  assert(i >= 0);
+  assert(i < _N);
+  assert(replicate >= 0);
+  assert(replicate < _K);
+  return _max_Sigma_eigenvalue[i*_K+replicate];
+}
+
+/**
+ * \brief    Get the maximum eigen value contribution of individual i in a replicate
+ * \details  --
+ * \param    int i
+ * \param    int replicate
+ * \return   \e double
+ */
+inline double ScalarPopulation::get_max_Sigma_contribution( int i, int replicate ) const
+{
+  assert(i >= 0);
+  assert(i < _N);
+  assert(replicate >= 0);
+  assert(replicate < _K);
+  return _max_Sigma_contribution[i*_K+replicate];
+}
+
+/**
+ * \brief    Get the dot product between Sigma maximum eigen vector and optimum direction of individual i in a replicate
+ * \details  --
+ * \param    int i
+ * \param    int replicate
+ * \return   \e double
+ */
+inline double ScalarPopulation::get_max_dot_product( int i, int replicate ) const
+{
+  assert(i >= 0);
+  assert(i < _N);
+  assert(replicate >= 0);
+  assert(replicate < _K);
+  return _max_dot_product[i*_K+replicate];
+}
+
+/**
+ * \brief    Get the size of the mu mutation of individual i in a replicate
+ * \details  --
+ * \param    int i
+ * \param    int replicate
+ * \return   \e double
+ */
+inline double ScalarPopulation::get_r_mu( int i, int replicate ) const
+{
+  assert(i >= 0);
+  assert(i < _N);
+  assert(replicate >= 0);
+  assert(replicate < _K);
+  return _r_mu[i*_K+replicate];
+}
+
+/**
+ * \brief    Get the size of the sigma mutation of individual i in a replicate
+ * \details  --
+ * \param    int i
+ * \param    int replicate
+ * \return   \e double
+ */
+inline double ScalarPopulation::get_r_sigma( int i, int replicate ) const
+{
+  assert(i >= 0);
+  assert(i < _N);
+  assert(replicate >= 0);
+  assert(replicate < _K);
+  return _r_sigma[i*_K+replicate];
+}
+
+/*----------------------------
+ * SETTERS
+ *----------------------------*/
+
+
+#endif /* defined(__SigmaFGM__ScalarPopulation__) */
@@ -0,0 +1,365 @@
+
+/**
+ * \file      Selection.cpp
+ * \authors   Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * \date      18-10-2026
+ * \copyright Copyright (C) 2016-2020 Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard. All rights reserved
+ * \license   This project is released under the GNU General Public License
+ * \brief     Selection class definition
+ */
+
+/***********************************************************************
+ * Copyright (C) 2016-2020
+ * Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * Web: https://github.com/charlesrocabert/SigmaFGM/
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#include "Selection.h"
+
+/* Number of blocks of the binomial splitting sampler. It does not depend on
+   the number of threads, so that the draws do not either */
+#define SELECTION_BLOCKS 64
+
+
+/*----------------------------
+ * CONSTRUCTORS
+ *----------------------------*/
+
+/**
+ * \brief    Constructor
+ * \details  All the samplers draw exactly from the multinomial distribution
+ *           with N trials over N categories, but they consume random numbers
+ *           differently: the same seed gives different draws
+ * \param    selection_sampler sampler
+ * \param    int N
+ * \param    ThreadPool* thread_pool
+ * \return   \e void
+ */
+Selection::Selection( selection_sampler sampler, int N, ThreadPool* thread_pool )
+{
+  assert(N > 0);
+  
+  /*----------------------------------------------- PARAMETERS */
+  
+  _sampler     = sampler;
+  _N           = N;
+  _thread_pool = thread_pool;
+  
+  /*----------------------------------------------- BUFFERS */
+  
+  _buffer      = new double[_N+1];
+  _nb_blocks   = 0;
+  _block_first = NULL;
+  _block_w     = NULL;
+  _block_draws = NULL;
+  _block_prngs = NULL;
+  if (_sampler == BINOMIAL_SPLITTING)
+  {
+    _nb_blocks   = (_N < SELECTION_BLOCKS ? _N : SELECTION_BLOCKS);
+    _block_first = new int[_nb_blocks+1];
+    _block_w     = new double[_nb_blocks+1];
+    _block_draws = new unsigned int[_nb_blocks];
+    _block_prngs = new Prng*[_nb_blocks];
+    for (int b = 0; b <= _nb_blocks; b++)
+    {
+      _block_first[b] = (int)((long long int)b*_N/_nb_blocks);
+    }
+    for (int b = 0; b < _nb_blocks; b++)
+    {
+      _block_prngs[b] = new Prng(PHILOX);
+    }
+  }
+}
+
+/*----------------------------
+ * DESTRUCTORS
+ *----------------------------*/
+
+/**
+ * \brief    Destructor
+ * \details  --
+ * \param    void
+ * \return   \e void
+ */
+Selection::~Selection( void )
+{
+  _thread_pool = NULL;
+  delete[] _buffer;
+  _buffer = NULL;
+  if (_sampler == BINOMIAL_SPLITTING)
+  {
+    for (int b = 0; b < _nb_blocks; b++)
+    {
+      delete _block_prngs[b];
+      _block_prngs[b] = NULL;
+    }
+    delete[] _block_prngs;
+    _block_prngs = NULL;
+    delete[] _block_first;
+    _block_first = NULL;
+    delete[] _block_w;
+    _block_w = NULL;
+    delete[] _block_draws;
+    _block_draws = NULL;
+  }
+}
+
+/*----------------------------
+ * PUBLIC METHODS
+ *----------------------------*/
+
+/**
+ * \brief    Draw the number of offspring of each individual
+ * \details  Weights do not need to be normalized
+ * \param    Prng* prng
+ * \param    const double* w
+ * \param    double w_sum
+ * \param    unsigned int* draws
+ * \return   \e void
+ */
+void Selection::draw( Prng* prng, const double* w, double w_sum, unsigned int* draws )
+{
+  assert(w_sum > 0.0);
+  switch (_sampler)
+  {
+    case GSL_MULTINOMIAL:
+      draw_gsl_multinomial(prng, w, w_sum, draws);
+      break;
+    case CONDITIONAL_BINOMIAL:
+      draw_conditional_binomial(prng, w, w_sum, _N, _N, draws);
+      break;
+    case SORTED_UNIFORMS:
+      draw_sorted_uniforms(prng, w, w_sum, draws);
+      break;
+    case BINOMIAL_SPLITTING:
+      draw_binomial_splitting(prng, w, draws);
+      break;
+  }
+}
+
+/*----------------------------
+ * PROTECTED METHODS
+ *----------------------------*/
+
+/**
+ * \brief    Draw with gsl_ran_multinomial
+ * \details  Weights are normalized first, which reproduces the original draws
+ * \param    Prng* prng
+ * \param    const double* w
+ * \param    double w_sum
+ * \param    unsigned int* draws
+ * \return   \e void
+ */
+void Selection::draw_gsl_multinomial( Prng* prng, const double* w, double w_sum, unsigned int* draws )
+{
+  for (int i = 0; i < _N; i++)
+  {
+    _buffer[i] = w[i]/w_sum;
+  }
+  prng->multinomial(draws, _buffer, _N, _N);
+}
+
+/**
+ * \brief    Draw n trials over K categories with conditional binomials
+ * \details  Category i receives Binomial(n_left, w[i]/w_left) trials, where
+ *           n_left and w_left are the trials and weight not yet handed out.
+ *           The loop stops as soon as all the trials are handed out
+ * \param    Prng* prng
+ * \param    const double* w
+ * \param    double w_sum
+ * \param    int n
+ * \param    int K
+ * \param    unsigned int* draws
+ * \return   \e void
+ */
+void Selection::draw_conditional_binomial( Prng* prng, const double* w, double w_sum, int n, int K, unsigned int* draws )
+{
+  unsigned int n_left        = (unsigned int)n;
+  double       w_left        = w_sum;
+  int          last_positive = -1;
+  int          i             = 0;
+  for (; i < K && n_left > 0; i++)
+  {
+    draws[i] = 0;
+    if (w[i] > 0.0)
+    {
+      last_positive = i;
+      if (w[i] >= w_left)
+      {
+        draws[i] = n_left;
+      }
+      else
+      {
+        draws[i] = (unsigned int)prng->binomial(n_left, w[i]/w_left);
+      }
+      n_left -= draws[i];
+      w_left -= w[i];
+    }
+  }
+  for (; i < K; i++)
+  {
+    draws[i] = 0;
+  }
+  /*** Rounding errors on w_left may leave a few trials ***/
+  if (n_left > 0)
+  {
+    assert(last_positive >= 0);
+    draws[last_positive] += n_left;
+  }
+}
+
+/**
+ * \brief    Draw by walking sorted uniforms along the cumulated weights
+ * \details  The N sorted uniforms are the normalized partial sums of N+1
+ *           exponential spacings, so they are drawn in O(N) without sorting
+ * \param    Prng* prng
+ * \param    const double* w
+ * \param    double w_sum
+ * \param    unsigned int* draws
+ * \return   \e void
+ */
+void Selection::draw_sorted_uniforms( Prng* prng, const double* w, double w_sum, unsigned int* draws )
+{
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 1) Draw the exponential spacings      */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  double total = 0.0;
+  for (int j = 0; j <= _N; j++)
+  {
+    _buffer[j]  = -log(1.0-prng->uniform());
+    total      += _buffer[j];
+  }
+  double scale = w_sum/total;
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 2) Walk the cumulated weights         */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  double cumulated     = 0.0;
+  double point         = _buffer[0]*scale;
+  int    j             = 0;
+  int    last_positive = -1;
+  for (int i = 0; i < _N; i++)
+  {
+    draws[i]   = 0;
+    cumulated += w[i];
+    if (w[i] > 0.0)
+    {
+      last_positive = i;
+    }
+    while (j < _N && point < cumulated)
+    {
+      draws[i]++;
+      j++;
+      point += _buffer[j]*scale;
+    }
+  }
+  /*** Rounding errors on the last points may leave a few trials ***/
+  if (j < _N)
+  {
+    assert(last_positive >= 0);
+    draws[last_positive] += (unsigned int)(_N-j);
+  }
+}
+
+/**
+ * \brief    Draw by recursive binomial splitting
+ * \details  Trials are first split between a fixed number of blocks of
+ *           categories by recursive binomials on the block weights. Then
+ *           each block draws its own trials with conditional binomials, from
+ *           a Philox stream keyed by 64 bits of the main prng and the block
+ *           index. Blocks of one draw never share a stream, and two draws
+ *           only collide if their 64-bit keys do. Blocks are computed on the
+ *           thread pool when there is one
+ * \param    Prng* prng
+ * \param    const double* w
+ * \param    unsigned int* draws
+ * \return   \e void
+ */
+void Selection::draw_binomial_splitting( Prng* prng, const double* w, unsigned int* draws )
+{
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 1) Compute the block weights          */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  _block_w[0] = 0.0;
+  for (int b = 0; b < _nb_blocks; b++)
+  {
+    double block_w = 0.0;
+    for (int i = _block_first[b]; i < _block_first[b+1]; i++)
+    {
+      block_w += w[i];
+    }
+    _block_w[b+1] = _block_w[b]+block_w;
+  }
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 2) Split the trials between blocks    */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  split_blocks(prng, 0, _nb_blocks, _N);
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 3) Draw the trials inside each block  */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  unsigned long int key = prng->draw_seed() & 0xFFFFFFFFUL;
+  key                   = (key << 32) | (prng->draw_seed() & 0xFFFFFFFFUL);
+  for (int b = 0; b < _nb_blocks; b++)
+  {
+    _block_prngs[b]->set_stream(key, 0, 0, (unsigned int)b, BLOCK_STREAM);
+  }
+  if (_thread_pool != NULL)
+  {
+    _thread_pool->run(_nb_blocks, [&]( int b )
+    {
+      int first = _block_first[b];
+      draw_conditional_binomial(_block_prngs[b], &w[first], _block_w[b+1]-_block_w[b], (int)_block_draws[b], _block_first[b+1]-first, &draws[first]);
+    });
+  }
+  else
+  {
+    for (int b = 0; b < _nb_blocks; b++)
+    {
+      int first = _block_first[b];
+      draw_conditional_binomial(_block_prngs[b], &w[first], _block_w[b+1]-_block_w[b], (int)_block_draws[b], _block_first[b+1]-first, &draws[first]);
+    }
+  }
+}
+
+/**
+ * \brief    Split n trials between blocks [first_block, last_block[
+ * \details  The left half receives Binomial(n, W_left/W) trials
+ * \param    Prng* prng
+ * \param    int first_block
+ * \param    int last_block
+ * \param    int n
+ * \return   \e void
+ */
+void Selection::split_blocks( Prng* prng, int first_block, int last_block, int n )
+{
+  if (last_block-first_block == 1)
+  {
+    _block_draws[first_block] = (unsigned int)n;
+    return;
+  }
+  int    middle = (first_block+last_block)/2;
+  double W      = _block_w[last_block]-_block_w[first_block];
+  double W_left = _block_w[middle]-_block_w[first_block];
+  int    n_left = 0;
+  if (n > 0 && W_left > 0.0)
+  {
+    n_left = (W_left >= W ? n : (int)prng->binomial((size_t)n, W_left/W));
+  }
+  split_blocks(prng, first_block, middle, n_left);
+  split_blocks(prng, middle, last_block, n-n_left);
+}
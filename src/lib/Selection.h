@@ -0,0 +1,131 @@
+
+/**
+ * \file      Selection.h
+ * \authors   Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * \date      18-10-2026
+ * \copyright Copyright (C) 2016-2020 Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard. All rights reserved
+ * \license   This project is released under the GNU General Public License
+ * \brief     Selection class declaration
+ */
+
+/***********************************************************************
+ * Copyright (C) 2016-2020
+ * Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * Web: https://github.com/charlesrocabert/SigmaFGM/
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#ifndef __SigmaFGM__Selection__
+#define __SigmaFGM__Selection__
+
+#include <iostream>
+#include <cmath>
+#include <assert.h>
+
+#include "Macros.h"
+#include "Enums.h"
+#include "Prng.h"
+#include "ThreadPool.h"
+
+
+class Selection
+{
+  
+public:
+  
+  /*----------------------------
+   * CONSTRUCTORS
+   *----------------------------*/
+  Selection( void ) = delete;
+  Selection( selection_sampler sampler, int N, ThreadPool* thread_pool );
+  Selection( const Selection& selection ) = delete;
+  
+  /*----------------------------
+   * DESTRUCTORS
+   *----------------------------*/
+  ~Selection( void );
+  
+  /*----------------------------
+   * GETTERS
+   *----------------------------*/
+  inline selection_sampler get_sampler( void ) const;
+  
+  /*----------------------------
+   * SETTERS
+   *----------------------------*/
+  Selection& operator=(const Selection&) = delete;
+  
+  /*----------------------------
+   * PUBLIC METHODS
+   *----------------------------*/
+  void draw( Prng* prng, const double* w, double w_sum, unsigned int* draws );
+  
+  /*----------------------------
+   * PUBLIC ATTRIBUTES
+   *----------------------------*/
+  
+protected:
+  
+  /*----------------------------
+   * PROTECTED METHODS
+   *----------------------------*/
+  void draw_gsl_multinomial( Prng* prng, const double* w, double w_sum, unsigned int* draws );
+  void draw_conditional_binomial( Prng* prng, const double* w, double w_sum, int n, int K, unsigned int* draws );
+  void draw_sorted_uniforms( Prng* prng, const double* w, double w_sum, unsigned int* draws );
+  void draw_binomial_splitting( Prng* prng, const double* w, unsigned int* draws );
+  void split_blocks( Prng* prng, int first_block, int last_block, int n );
+  
+  /*----------------------------
+   * PROTECTED ATTRIBUTES
+   *----------------------------*/
+  
+  /*----------------------------------------------- PARAMETERS */
+  
+  selection_sampler _sampler;     /*!< Multinomial sampler                             */
+  int               _N;           /*!< Number of trials and of categories              */
+  ThreadPool*       _thread_pool; /*!< Thread pool (NULL to split blocks sequentially) */
+  
+  /*----------------------------------------------- BUFFERS */
+  
+  double*       _buffer;      /*!< Normalized weights or uniform spacings */
+  int           _nb_blocks;   /*!< Number of blocks (binomial splitting)  */
+  int*          _block_first; /*!< First category of each block           */
+  double*       _block_w;     /*!< Weight prefix sums over blocks         */
+  unsigned int* _block_draws; /*!< Number of trials given to each block   */
+  Prng**        _block_prngs; /*!< Philox stream of each block            */
+};
+
+
+/*----------------------------
+ * GETTERS
+ *----------------------------*/
+
+/**
+ * \brief    Get the multinomial sampler
+ * \details  --
+ * \param    void
+ * \return   \e selection_sampler
+ */
+inline selection_sampler Selection::get_sampler( void ) const
+{
+  return _sampler;
+}
+
+/*----------------------------
+ * SETTERS
+ *----------------------------*/
+
+
+#endif /* defined(__SigmaFGM__Selection__) */
@@ -29,6 +29,8 @@
 
 #include "Simulation.h"
 
+#define STATISTICS_WRITER_CAPACITY 64
+
 
 /*----------------------------
  * CONSTRUCTORS
@@ -51,10 +53,117 @@ Simulation::Simulation( Parameters* parameters )
   
   /*----------------------------------------------- SIMULATION */
   
-  _environment = new Environment(_parameters);
-  _tree        = new Tree();
-  _population  = new Population(_parameters, _environment, _tree);
-  _statistics  = new Statistics();
+  _thread_pool       = NULL;
+  _environment       = new Environment(_parameters);
+  _tree              = (_parameters->get_lineage_tracking() ? new Tree(_parameters->get_collapse_unary()) : NULL);
+  _lineage_log       = (_parameters->get_lineage_log() ? new LineageLog() : NULL);
+  _genealogy_writer  = NULL;
+  if (_parameters->get_genealogy_interval() > 0)
+  {
+    assert(_tree != NULL);
+    _genealogy_writer = new GenealogyWriter("genealogy_nodes.bin", "genealogy_edges.bin");
+  }
+  _genealogy_countdown = _parameters->get_genealogy_interval();
+  _mutation_log        = NULL;
+  if (_parameters->get_mutation_log())
+  {
+    assert(_tree != NULL);
+    _mutation_log = new MutationLog("mutation_events.bin", "mutation_fates.bin", _parameters->get_population_size());
+    _tree->set_mutation_log(_mutation_log);
+  }
+  
+  /*----------------------------------------------- OUTPUT THREAD */
+  
+  /* The output thread is started before the thread pool pins the calling */
+  /* thread, so that it keeps the affinity mask of the process            */
+  _statistics_writer = NULL;
+  if (_parameters->get_async_output())
+  {
+    _statistics_writer = new StatisticsWriter(STATISTICS_WRITER_CAPACITY);
+  }
+  
+  /*----------------------------------------------- POPULATION */
+  
+  _population        = NULL;
+  _scalar_population = NULL;
+  _metapopulation    = NULL;
+  if (_parameters->get_number_of_demes() > 1)
+  {
+    assert(_parameters->get_number_of_replicates() == 1);
+    if (_parameters->get_number_of_threads() > 0)
+    {
+      _thread_pool = new ThreadPool(_parameters->get_number_of_threads(), _parameters->get_pin_threads());
+    }
+    _metapopulation = new Metapopulation(_parameters, _environment, _tree, _thread_pool);
+  }
+  else if (_parameters->get_number_of_dimensions() == 1 && _parameters->get_population_model() == WRIGHT_FISHER && !_parameters->get_skip_monomorphic() && !_parameters->get_common_random_numbers() && !_parameters->get_lineage_tracking() && !_parameters->get_lineage_log())
+  {
+    if (_parameters->get_number_of_threads() > 0)
+    {
+      _thread_pool = new ThreadPool(_parameters->get_number_of_threads(), _parameters->get_pin_threads());
+    }
+    _scalar_population = new ScalarPopulation(_parameters, _environment, _thread_pool);
+  }
+  else
+  {
+    assert(_parameters->get_number_of_replicates() == 1);
+    if (_parameters->get_number_of_threads() > 0)
+    {
+      _thread_pool = new ThreadPool(_parameters->get_number_of_threads(), _parameters->get_pin_threads());
+    }
+    _population = new Population(_parameters, _environment, _tree, _lineage_log, _thread_pool, _prng, _parameters->get_population_size());
+  }
+  
+  /*----------------------------------------------- STATISTICS */
+  
+  _number_of_replicates = _parameters->get_number_of_replicates();
+  _statistics           = new Statistics*[_number_of_replicates];
+  if (_parameters->get_common_random_numbers())
+  {
+    assert(_number_of_replicates == 1);
+    _statistics[0] = new Statistics("variant_"+std::to_string(_parameters->get_variant()));
+  }
+  else if (_number_of_replicates == 1)
+  {
+    _statistics[0] = new Statistics();
+    _statistics[0]->set_lineage_columns(_tree != NULL);
+  }
+  else
+  {
+    for (int k = 0; k < _number_of_replicates; k++)
+    {
+      _statistics[k] = new Statistics(std::to_string(k));
+    }
+  }
+  for (int k = 0; k < _number_of_replicates; k++)
+  {
+    _statistics[k]->set_prng_type(_parameters->get_prng_type());
+  }
+  _number_of_demes = _parameters->get_number_of_demes();
+  _deme_statistics = NULL;
+  if (_metapopulation != NULL)
+  {
+    _deme_statistics = new Statistics*[_number_of_demes];
+    for (int d = 0; d < _number_of_demes; d++)
+    {
+      _deme_statistics[d] = new Statistics("deme_"+std::to_string(d));
+      _deme_statistics[d]->set_prng_type(_parameters->get_prng_type());
+      _deme_statistics[d]->write_headers();
+    }
+  }
+  
+  /* Headers are written directly, the output thread only writes statistics */
+  if (_statistics_writer != NULL)
+  {
+    for (int k = 0; k < _number_of_replicates; k++)
+    {
+      _statistics[k]->set_writer(_statistics_writer);
+    }
+    for (int d = 0; _deme_statistics != NULL && d < _number_of_demes; d++)
+    {
+      _deme_statistics[d]->set_writer(_statistics_writer);
+    }
+  }
 }
 
 /*----------------------------
@@ -80,10 +189,44 @@ Simulation::~Simulation( void )
   _environment = NULL;
   delete _population;
   _population = NULL;
+  delete _scalar_population;
+  _scalar_population = NULL;
+  delete _metapopulation;
+  _metapopulation = NULL;
   delete _tree;
   _tree = NULL;
-  delete _statistics;
+  delete _lineage_log;
+  _lineage_log = NULL;
+  delete _genealogy_writer;
+  _genealogy_writer = NULL;
+  delete _mutation_log;
+  _mutation_log = NULL;
+  if (_statistics_writer != NULL)
+  {
+    _statistics_writer->drain();
+  }
+  for (int k = 0; k < _number_of_replicates; k++)
+  {
+    delete _statistics[k];
+    _statistics[k] = NULL;
+  }
+  delete[] _statistics;
   _statistics = NULL;
+  if (_deme_statistics != NULL)
+  {
+    for (int d = 0; d < _number_of_demes; d++)
+    {
+      _deme_statistics[d]->close();
+      delete _deme_statistics[d];
+      _deme_statistics[d] = NULL;
+    }
+    delete[] _deme_statistics;
+    _deme_statistics = NULL;
+  }
+  delete _statistics_writer;
+  _statistics_writer = NULL;
+  delete _thread_pool;
+  _thread_pool = NULL;
 }
 
 /*----------------------------
@@ -99,9 +242,16 @@ Simulation::~Simulation( void )
 void Simulation::stabilize( int generations )
 {
   _environment->stabilizing_environment();
-  for (int g = 1; g <= generations; g++)
+  int g = 1;
+  while (g <= generations)
   {
-    _population->compute_next_generation(g);
+    g += skip_monomorphic_generations(generations-g+1);
+    if (g > generations)
+    {
+      break;
+    }
+    compute_next_generation(g);
+    g++;
   }
 }
 
@@ -114,22 +264,75 @@ void Simulation::stabilize( int generations )
 void Simulation::run( int generations )
 {
   _environment->normal_environment();
-  _statistics->write_headers();
-  for (int g = 1; g <= generations; g++)
+  for (int k = 0; k < _number_of_replicates; k++)
   {
-    _population->compute_next_generation(g);
-    _statistics->reset();
-    _statistics->compute_statistics(_population);
-    _statistics->write_statistics(g);
-    _statistics->flush();
+    _statistics[k]->write_headers();
   }
-  _statistics->close();
-  //_tree->write_best_lineage_statistics();
+  if (_tree != NULL)
+  {
+    _tree->reset_fixations();
+  }
+  if (_mutation_log != NULL)
+  {
+    _mutation_log->reset_statistics();
+  }
+  int g = 1;
+  while (g <= generations)
+  {
+    /*** Skipped generations write the expected statistics of the monomorphic genotype ***/
+    int skipped = (g > 1 ? skip_monomorphic_generations(generations-g+1) : 0);
+    if (skipped > 0)
+    {
+      _statistics[0]->compute_statistics(_population->compute_monomorphic_statistics(g));
+    }
+    for (int s = 0; s < skipped; s++, g++)
+    {
+      compute_lineage_statistics(g);
+      _statistics[0]->write_statistics(g);
+    }
+    if (g > generations)
+    {
+      break;
+    }
+    compute_next_generation(g);
+    compute_lineage_statistics(g);
+    for (int k = 0; k < _number_of_replicates; k++)
+    {
+      _statistics[k]->reset();
+      compute_statistics(k);
+      _statistics[k]->write_statistics(g);
+      _statistics[k]->flush();
+    }
+    write_deme_statistics(g);
+    if (fixation_stop_reached())
+    {
+      break;
+    }
+    g++;
+  }
+  for (int k = 0; k < _number_of_replicates; k++)
+  {
+    _statistics[k]->close();
+  }
+  if (_tree != NULL)
+  {
+    _tree->write_best_lineage_statistics();
+  }
+  if (_lineage_log != NULL)
+  {
+    _lineage_log->write_best_lineage_statistics();
+  }
+  close_genealogy();
+  close_mutation_log();
 }
 
 /**
  * \brief    Run the simulation with shutoff
- * \details  --
+ * \details  Each replicate stops writing its statistics when it reaches the
+ *           shutoff distance; the simulation stops when all replicates did.
+ *           Skipped monomorphic generations share one set of expected
+ *           statistics: if it reaches the shutoff distance, the simulation
+ *           stops at the first skipped generation
  * \param    double shutoff_distance
  * \param    int shutoff_generation
  * \return   \e void
@@ -137,31 +340,246 @@ void Simulation::run( int generations )
 void Simulation::run_with_shutoff( double shutoff_distance, int shutoff_generation )
 {
   _environment->normal_environment();
-  _statistics->write_headers();
-  int  g       = 0;
-  bool shutoff = false;
-  while (!shutoff)
+  bool* shutoff = new bool[_number_of_replicates];
+  for (int k = 0; k < _number_of_replicates; k++)
   {
-    g++;
-    _population->compute_next_generation(g);
-    _statistics->reset();
-    _statistics->compute_statistics(_population);
-    _statistics->write_statistics(g);
-    _statistics->flush();
-    if (fabs(_statistics->get_dmu_mean()) <= fabs(shutoff_distance))
+    _statistics[k]->write_headers();
+    shutoff[k] = false;
+  }
+  if (_tree != NULL)
+  {
+    _tree->reset_fixations();
+  }
+  if (_mutation_log != NULL)
+  {
+    _mutation_log->reset_statistics();
+  }
+  int g       = 0;
+  int running = _number_of_replicates;
+  while (running > 0)
+  {
+    /*** Skipped generations write the expected statistics of the monomorphic genotype ***/
+    int  remaining = (shutoff_generation > g ? shutoff_generation-g : INT_MAX-g);
+    int  skipped   = (g > 0 ? skip_monomorphic_generations(remaining) : 0);
+    bool reached   = false;
+    if (skipped > 0)
+    {
+      _statistics[0]->compute_statistics(_population->compute_monomorphic_statistics(g+1));
+      
+      /*** The population is identical during the skip, so the shutoff distance is checked once ***/
+      if (fabs(_statistics[0]->get_dmu_mean()) <= fabs(shutoff_distance))
+      {
+        reached = true;
+        skipped = 1;
+      }
+    }
+    for (int s = 0; s < skipped && running > 0; s++)
     {
-      shutoff = true;
+      g++;
+      compute_lineage_statistics(g);
+      _statistics[0]->write_statistics(g);
+      if (reached || g == shutoff_generation)
+      {
+        shutoff[0] = true;
+        running--;
+      }
     }
-    if (g == shutoff_generation)
+    if (running == 0)
     {
-      shutoff = true;
+      break;
     }
+    g++;
+    compute_next_generation(g);
+    compute_lineage_statistics(g);
+    for (int k = 0; k < _number_of_replicates; k++)
+    {
+      if (shutoff[k])
+      {
+        continue;
+      }
+      _statistics[k]->reset();
+      compute_statistics(k);
+      _statistics[k]->write_statistics(g);
+      _statistics[k]->flush();
+      if (fabs(_statistics[k]->get_dmu_mean()) <= fabs(shutoff_distance) || g == shutoff_generation || fixation_stop_reached())
+      {
+        shutoff[k] = true;
+        running--;
+      }
+    }
+    write_deme_statistics(g);
+  }
+  for (int k = 0; k < _number_of_replicates; k++)
+  {
+    _statistics[k]->close();
+  }
+  delete[] shutoff;
+  shutoff = NULL;
+  if (_tree != NULL)
+  {
+    _tree->write_best_lineage_statistics();
+  }
+  if (_lineage_log != NULL)
+  {
+    _lineage_log->write_best_lineage_statistics();
   }
-  _statistics->close();
-  //_tree->write_best_lineage_statistics();
+  close_genealogy();
+  close_mutation_log();
 }
 
 /*----------------------------
  * PROTECTED METHODS
  *----------------------------*/
 
+/**
+ * \brief    Compute the next generation with the population engine in use
+ * \details  --
+ * \param    int next_generation
+ * \return   \e void
+ */
+void Simulation::compute_next_generation( int next_generation )
+{
+  if (_mutation_log != NULL)
+  {
+    _mutation_log->set_generation(next_generation);
+  }
+  if (_scalar_population != NULL)
+  {
+    _scalar_population->compute_next_generation(next_generation);
+  }
+  else if (_metapopulation != NULL)
+  {
+    _metapopulation->compute_next_generation(next_generation);
+  }
+  else
+  {
+    _population->compute_next_generation(next_generation);
+  }
+  if (_tree != NULL)
+  {
+    _tree->update_mrca();
+  }
+  if (_genealogy_writer != NULL && --_genealogy_countdown == 0)
+  {
+    _tree->simplify(_genealogy_writer);
+    _genealogy_countdown = _parameters->get_genealogy_interval();
+  }
+}
+
+/**
+ * \brief    Compute the statistics of a replicate with the population engine in use
+ * \details  --
+ * \param    int replicate
+ * \return   \e void
+ */
+void Simulation::compute_statistics( int replicate )
+{
+  if (_scalar_population != NULL)
+  {
+    _statistics[replicate]->compute_statistics(_scalar_population, replicate);
+  }
+  else if (_metapopulation != NULL)
+  {
+    _statistics[replicate]->compute_statistics(_metapopulation);
+  }
+  else
+  {
+    _statistics[replicate]->compute_statistics(_population);
+  }
+}
+
+/**
+ * \brief    Compute the lineage statistics
+ * \details  Does nothing without lineage tracking
+ * \param    int generation
+ * \return   \e void
+ */
+void Simulation::compute_lineage_statistics( int generation )
+{
+  if (_tree == NULL)
+  {
+    return;
+  }
+  _statistics[0]->compute_statistics(_tree, generation);
+}
+
+/**
+ * \brief    Check if the fixation stop is reached
+ * \details  Always false without fixation stop
+ * \param    void
+ * \return   \e bool
+ */
+bool Simulation::fixation_stop_reached( void ) const
+{
+  return (_parameters->get_fixation_stop() > 0 && _tree->get_number_of_fixed_beneficial_mutations() >= (unsigned long long int)_parameters->get_fixation_stop());
+}
+
+/**
+ * \brief    Write the statistics of each deme
+ * \details  Does nothing without demes
+ * \param    int generation
+ * \return   \e void
+ */
+void Simulation::write_deme_statistics( int generation )
+{
+  if (_metapopulation == NULL)
+  {
+    return;
+  }
+  for (int d = 0; d < _number_of_demes; d++)
+  {
+    _deme_statistics[d]->reset();
+    _deme_statistics[d]->compute_statistics(_metapopulation->get_deme(d));
+    _deme_statistics[d]->write_statistics(generation);
+    _deme_statistics[d]->flush();
+  }
+}
+
+/**
+ * \brief    Write the remaining genealogy and close the tables
+ * \details  Does nothing if the genealogy is not exported
+ * \param    void
+ * \return   \e void
+ */
+void Simulation::close_genealogy( void )
+{
+  if (_genealogy_writer == NULL)
+  {
+    return;
+  }
+  _tree->write_genealogy(_genealogy_writer);
+  _genealogy_writer->close();
+}
+
+/**
+ * \brief    Write the fixation statistics and close the mutation log
+ * \details  Does nothing if mutations are not logged
+ * \param    void
+ * \return   \e void
+ */
+void Simulation::close_mutation_log( void )
+{
+  if (_mutation_log == NULL)
+  {
+    return;
+  }
+  _mutation_log->write_fixation_statistics();
+  _mutation_log->close();
+}
+
+/**
+ * \brief    Skip the mutation-free generations of a monomorphic population
+ * \details  Only when enabled, for a single Wright-Fisher population (the
+ *           population is checked for monomorphism first). Returns the number
+ *           of generations skipped, at most remaining_generations
+ * \param    int remaining_generations
+ * \return   \e int
+ */
+int Simulation::skip_monomorphic_generations( int remaining_generations )
+{
+  if (!_parameters->get_skip_monomorphic() || _population == NULL || remaining_generations <= 0 || !_population->is_monomorphic())
+  {
+    return 0;
+  }
+  return _population->skip_mutation_free_generations(remaining_generations);
+}
@@ -31,6 +31,7 @@
 #define __SigmaFGM__Simulation__
 
 #include <iostream>
+#include <climits>
 #include <assert.h>
 
 #include "Macros.h"
@@ -39,8 +40,15 @@
 #include "Parameters.h"
 #include "Environment.h"
 #include "Tree.h"
+#include "LineageLog.h"
+#include "GenealogyWriter.h"
+#include "MutationLog.h"
 #include "Population.h"
+#include "ScalarPopulation.h"
+#include "Metapopulation.h"
 #include "Statistics.h"
+#include "StatisticsWriter.h"
+#include "ThreadPool.h"
 
 
 class Simulation
@@ -85,6 +93,14 @@ protected:
   /*----------------------------
    * PROTECTED METHODS
    *----------------------------*/
+  void compute_next_generation( int next_generation );
+  void compute_statistics( int replicate );
+  void compute_lineage_statistics( int generation );
+  bool fixation_stop_reached( void ) const;
+  void write_deme_statistics( int generation );
+  void close_genealogy( void );
+  void close_mutation_log( void );
+  int  skip_monomorphic_generations( int remaining_generations );
   
   /*----------------------------
    * PROTECTED ATTRIBUTES
@@ -97,10 +113,21 @@ protected:
   
   /*----------------------------------------------- SIMULATION */
   
-  Environment* _environment; /*!< Environment  */
-  Tree*        _tree;        /*!< Lineage tree */
-  Population*  _population;  /*!< Population   */
-  Statistics*  _statistics;  /*!< Statistics   */
+  ThreadPool*       _thread_pool;          /*!< Thread pool (NULL without threads)                */
+  Environment*      _environment;          /*!< Environment                                       */
+  Tree*             _tree;                 /*!< Lineage tree (NULL without lineage tracking)      */
+  LineageLog*       _lineage_log;          /*!< Lineage log (NULL without lineage log)            */
+  GenealogyWriter*  _genealogy_writer;     /*!< Genealogy tables (NULL if not exported)           */
+  MutationLog*      _mutation_log;         /*!< Mutation events (NULL if not logged)              */
+  int               _genealogy_countdown;  /*!< Generations left before the next export           */
+  Population*       _population;           /*!< Population (NULL in one dimension or with demes)  */
+  ScalarPopulation* _scalar_population;    /*!< One-dimensional population (NULL otherwise)       */
+  Metapopulation*   _metapopulation;       /*!< Demes (NULL without demes)                        */
+  int               _number_of_replicates; /*!< Number of replicates run in lockstep              */
+  Statistics**      _statistics;           /*!< Statistics (one per replicate)                    */
+  int               _number_of_demes;      /*!< Number of demes                                   */
+  Statistics**      _deme_statistics;      /*!< Statistics of each deme (NULL without demes)      */
+  StatisticsWriter* _statistics_writer;    /*!< Output thread (NULL to write files directly)      */
   
 };
 
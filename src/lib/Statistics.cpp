@@ -69,10 +69,52 @@ Statistics::Statistics( void )
   _r_sigma_sd         = 0.0;
   _r_theta_sd         = 0.0;
   
+  /*----------------------------------------------- LINEAGE STATISTICS */
+  
+  _lineage.enabled          = false;
+  _lineage.mrca             = 0;
+  _lineage.tmrca            = -1;
+  _lineage.fixed            = 0;
+  _lineage.fixed_beneficial = 0;
+  
   /*----------------------------------------------- STATISTIC FILES */
   
   _mean_file.open("mean.txt", std::ios::out | std::ios::trunc);
   _sd_file.open("sd.txt", std::ios::out | std::ios::trunc);
+  _writer    = NULL;
+  _prng_type = MT19937;
+}
+
+/**
+ * \brief    Suffixed constructor
+ * \details  Statistics are written in mean_<suffix>.txt and sd_<suffix>.txt
+ *           (one pair of files per replicate or per deme)
+ * \param    const std::string& suffix
+ * \return   \e void
+ */
+Statistics::Statistics( const std::string& suffix )
+{
+  assert(!suffix.empty());
+  reset();
+  
+  /*----------------------------------------------- LINEAGE STATISTICS */
+  
+  _lineage.enabled          = false;
+  _lineage.mrca             = 0;
+  _lineage.tmrca            = -1;
+  _lineage.fixed            = 0;
+  _lineage.fixed_beneficial = 0;
+  
+  /*----------------------------------------------- STATISTIC FILES */
+  
+  std::stringstream mean_filename;
+  std::stringstream sd_filename;
+  mean_filename << "mean_" << suffix << ".txt";
+  sd_filename << "sd_" << suffix << ".txt";
+  _mean_file.open(mean_filename.str().c_str(), std::ios::out | std::ios::trunc);
+  _sd_file.open(sd_filename.str().c_str(), std::ios::out | std::ios::trunc);
+  _writer    = NULL;
+  _prng_type = MT19937;
 }
 
 /*----------------------------
@@ -96,13 +138,20 @@ Statistics::~Statistics( void )
 
 /**
  * \brief    Write file headers
- * \details  --
+ * \details  Column names are preceded by a comment line giving the prng
+ *           algorithm, since the same seed gives different runs with
+ *           different algorithms
  * \param    void
  * \return   \e void
  */
 void Statistics::write_headers( void )
 {
   
+  /*----------------------------------------------- PRNG ALGORITHM */
+  
+  _mean_file << "# prng " << Prng::get_type_name(_prng_type) << "\n";
+  _sd_file << "# prng " << Prng::get_type_name(_prng_type) << "\n";
+  
   /*----------------------------------------------- MEAN VALUES */
   
   _mean_file << "g" << " ";
@@ -115,7 +164,15 @@ void Statistics::write_headers( void )
   _mean_file << "EV_dot_product" << " ";
   _mean_file << "r_mu" << " ";
   _mean_file << "r_sigma" << " ";
-  _mean_file << "r_theta" << "\n";
+  _mean_file << "r_theta";
+  if (_lineage.enabled)
+  {
+    _mean_file << " " << "mrca";
+    _mean_file << " " << "tmrca";
+    _mean_file << " " << "fixed";
+    _mean_file << " " << "fixed_beneficial";
+  }
+  _mean_file << "\n";
   
   /*----------------------------------------------- STANDARD DEVIATION VALUES */
   
@@ -133,171 +190,154 @@ void Statistics::write_headers( void )
 }
 
 /**
- * \brief    Compute statistics from the population
- * \details  --
- * \param    Population* population
+ * \brief    Compute statistics from an accumulator
+ * \details  The accumulator holds running means and squared deviations, so
+ *           no E[x^2]-E[x]^2 cancellation can occur
+ * \param    const StatisticsAccumulator* accumulator
  * \return   \e void
  */
-void Statistics::compute_statistics( Population* population )
+void Statistics::compute_statistics( const StatisticsAccumulator* accumulator )
 {
-  for (int i = 0; i < population->get_population_size(); i++)
-  {
-    Individual* ind = population->get_individual(i);
-    
-    /*----------------------------------------------- MEAN VALUES */
-    
-    _dmu_mean             += ind->get_dmu();
-    _dz_mean              += ind->get_dz();
-    _Wmu_mean             += ind->get_Wmu();
-    _Wz_mean              += ind->get_Wz();
-    _EV_mean              += ind->get_max_Sigma_eigenvalue();
-    _EV_contribution_mean += ind->get_max_Sigma_contribution();
-    _EV_dot_product_mean  += ind->get_max_dot_product();
-    _r_mu_mean            += ind->get_r_mu();
-    _r_sigma_mean         += ind->get_r_sigma();
-    _r_theta_mean         += ind->get_r_theta();
-    
-    /*----------------------------------------------- STANDARD DEVIATION VALUES */
-    
-    _dmu_sd             += ind->get_dmu()*ind->get_dmu();
-    _dz_sd              += ind->get_dz()*ind->get_dz();
-    _Wmu_sd             += ind->get_Wmu()*ind->get_Wmu();
-    _Wz_sd              += ind->get_Wz()*ind->get_Wz();
-    _EV_sd              += ind->get_max_Sigma_eigenvalue()*ind->get_max_Sigma_eigenvalue();
-    _EV_contribution_sd += ind->get_max_Sigma_contribution()*ind->get_max_Sigma_contribution();
-    _EV_dot_product_sd  += ind->get_max_dot_product()*ind->get_max_dot_product();
-    _r_mu_sd            += ind->get_r_mu()*ind->get_r_mu();
-    _r_sigma_sd         += ind->get_r_sigma()*ind->get_r_sigma();
-    _r_theta_sd         += ind->get_r_theta()*ind->get_r_theta();
-  }
-  
-  double N = (double)population->get_population_size();
-  
   /*----------------------------------------------- MEAN VALUES */
   
-  _dmu_mean             /= N;
-  _dz_mean              /= N;
-  _Wmu_mean             /= N;
-  _Wz_mean              /= N;
-  _EV_mean              /= N;
-  _EV_contribution_mean /= N;
-  _EV_dot_product_mean  /= N;
-  _r_mu_mean            /= N;
-  _r_sigma_mean         /= N;
-  _r_theta_mean         /= N;
+  _dmu_mean             = accumulator->get_mean(DMU_STATISTIC);
+  _dz_mean              = accumulator->get_mean(DZ_STATISTIC);
+  _Wmu_mean             = accumulator->get_mean(WMU_STATISTIC);
+  _Wz_mean              = accumulator->get_mean(WZ_STATISTIC);
+  _EV_mean              = accumulator->get_mean(EV_STATISTIC);
+  _EV_contribution_mean = accumulator->get_mean(EV_CONTRIBUTION_STATISTIC);
+  _EV_dot_product_mean  = accumulator->get_mean(EV_DOT_PRODUCT_STATISTIC);
+  _r_mu_mean            = accumulator->get_mean(R_MU_STATISTIC);
+  _r_sigma_mean         = accumulator->get_mean(R_SIGMA_STATISTIC);
+  _r_theta_mean         = accumulator->get_mean(R_THETA_STATISTIC);
   
   /*----------------------------------------------- STANDARD DEVIATION VALUES */
   
-  _dmu_sd             /= N;
-  _dz_sd              /= N;
-  _Wmu_sd             /= N;
-  _Wz_sd              /= N;
-  _EV_sd              /= N;
-  _EV_contribution_sd /= N;
-  _EV_dot_product_sd  /= N;
-  _r_mu_sd            /= N;
-  _r_sigma_sd         /= N;
-  _r_theta_sd         -= N;
-  _dmu_sd             -= _dmu_mean*_dmu_mean;
-  _dz_sd              -= _dz_mean*_dz_mean;
-  _Wmu_sd             -= _Wmu_mean*_Wmu_mean;
-  _Wz_sd              -= _Wz_mean*_Wz_mean;
-  _EV_sd              -= _EV_mean*_EV_mean;
-  _EV_contribution_sd -= _EV_contribution_mean*_EV_contribution_mean;
-  _EV_dot_product_sd  -= _EV_dot_product_mean*_EV_dot_product_mean;
-  _r_mu_sd            -= _r_mu_mean*_r_mu_mean;
-  _r_sigma_sd         -= _r_sigma_mean*_r_sigma_mean;
-  _r_theta_sd         -= _r_theta_mean*_r_theta_mean;
-  if (_dmu_sd < 1e-15)
-  {
-    _dmu_sd = 0.0;
-  }
-  else
-  {
-    _dmu_sd = sqrt(_dmu_sd);
-  }
-  if (_dz_sd < 1e-15)
-  {
-    _dz_sd = 0.0;
-  }
-  else
-  {
-    _dz_sd = sqrt(_dz_sd);
-  }
-  if (_Wmu_sd < 1e-15)
-  {
-    _Wmu_sd = 0.0;
-  }
-  else
-  {
-    _Wmu_sd = sqrt(_Wmu_sd);
-  }
-  if (_Wz_sd < 1e-15)
-  {
-    _Wz_sd = 0.0;
-  }
-  else
-  {
-    _Wz_sd = sqrt(_Wz_sd);
-  }
-  if (_EV_sd < 1e-15)
-  {
-    _EV_sd = 0.0;
-  }
-  else
-  {
-    _EV_sd = sqrt(_EV_sd);
-  }
-  if (_EV_contribution_sd < 1e-15)
-  {
-    _EV_contribution_sd = 0.0;
-  }
-  else
-  {
-    _EV_contribution_sd = sqrt(_EV_contribution_sd);
-  }
-  if (_EV_dot_product_sd < 1e-15)
-  {
-    _EV_dot_product_sd = 0.0;
-  }
-  else
-  {
-    _EV_dot_product_sd = sqrt(_EV_dot_product_sd);
-  }
-  if (_r_mu_sd < 1e-15)
-  {
-    _r_mu_sd = 0.0;
-  }
-  else
-  {
-    _r_mu_sd = sqrt(_r_mu_sd);
-  }
-  if (_r_sigma_sd < 1e-15)
-  {
-    _r_sigma_sd = 0.0;
-  }
-  else
-  {
-    _r_sigma_sd = sqrt(_r_sigma_sd);
-  }
-  if (_r_theta_sd < 1e-15)
+  _dmu_sd             = sqrt(accumulator->get_variance(DMU_STATISTIC));
+  _dz_sd              = sqrt(accumulator->get_variance(DZ_STATISTIC));
+  _Wmu_sd             = sqrt(accumulator->get_variance(WMU_STATISTIC));
+  _Wz_sd              = sqrt(accumulator->get_variance(WZ_STATISTIC));
+  _EV_sd              = sqrt(accumulator->get_variance(EV_STATISTIC));
+  _EV_contribution_sd = sqrt(accumulator->get_variance(EV_CONTRIBUTION_STATISTIC));
+  _EV_dot_product_sd  = sqrt(accumulator->get_variance(EV_DOT_PRODUCT_STATISTIC));
+  _r_mu_sd            = sqrt(accumulator->get_variance(R_MU_STATISTIC));
+  _r_sigma_sd         = sqrt(accumulator->get_variance(R_SIGMA_STATISTIC));
+  _r_theta_sd         = sqrt(accumulator->get_variance(R_THETA_STATISTIC));
+}
+
+/**
+ * \brief    Compute statistics from the population
+ * \details  The population accumulates its statistics while computing offspring,
+ *           so individuals are not visited again
+ * \param    Population* population
+ * \return   \e void
+ */
+void Statistics::compute_statistics( Population* population )
+{
+  compute_statistics(population->get_statistics_accumulator());
+}
+
+/**
+ * \brief    Compute statistics from the one-dimensional population
+ * \details  There is no theta mutation in one dimension
+ * \param    ScalarPopulation* population
+ * \param    int replicate
+ * \return   \e void
+ */
+void Statistics::compute_statistics( ScalarPopulation* population, int replicate )
+{
+  StatisticsAccumulator accumulator;
+  double values[NUMBER_OF_STATISTICS];
+  for (int i = 0; i < population->get_population_size(); i++)
   {
-    _r_theta_sd = 0.0;
+    values[DMU_STATISTIC]             = population->get_dmu(i, replicate);
+    values[DZ_STATISTIC]              = population->get_dz(i, replicate);
+    values[WMU_STATISTIC]             = population->get_Wmu(i, replicate);
+    values[WZ_STATISTIC]              = population->get_Wz(i, replicate);
+    values[EV_STATISTIC]              = population->get_max_Sigma_eigenvalue(i, replicate);
+    values[EV_CONTRIBUTION_STATISTIC] = population->get_max_Sigma_contribution(i, replicate);
+    values[EV_DOT_PRODUCT_STATISTIC]  = population->get_max_dot_product(i, replicate);
+    values[R_MU_STATISTIC]            = population->get_r_mu(i, replicate);
+    values[R_SIGMA_STATISTIC]         = population->get_r_sigma(i, replicate);
+    values[R_THETA_STATISTIC]         = 0.0;
+    accumulator.add_values(values);
   }
-  else
+  compute_statistics(&accumulator);
+}
+
+/**
+ * \brief    Compute statistics over all the demes
+ * \details  --
+ * \param    Metapopulation* metapopulation
+ * \return   \e void
+ */
+void Statistics::compute_statistics( Metapopulation* metapopulation )
+{
+  StatisticsAccumulator accumulator;
+  for (int d = 0; d < metapopulation->get_number_of_demes(); d++)
   {
-    _r_theta_sd = sqrt(_r_theta_sd);
+    accumulator.merge(metapopulation->get_deme(d)->get_statistics_accumulator());
   }
+  compute_statistics(&accumulator);
+}
+
+/**
+ * \brief    Compute the lineage statistics
+ * \details  The MRCA must be updated (see Tree::update_mrca())
+ * \param    const Tree* tree
+ * \param    int generation
+ * \return   \e void
+ */
+void Statistics::compute_statistics( const Tree* tree, int generation )
+{
+  assert(_lineage.enabled);
+  unsigned int mrca         = tree->get_mrca();
+  _lineage.mrca             = (mrca == NO_NODE ? 0 : tree->get_record(mrca)->identifier);
+  _lineage.tmrca            = (mrca == NO_NODE ? -1 : generation-tree->get_record(mrca)->generation);
+  _lineage.fixed            = tree->get_number_of_fixed_mutations();
+  _lineage.fixed_beneficial = tree->get_number_of_fixed_beneficial_mutations();
 }
 
 /**
  * \brief    Write statistics
- * \details  --
+ * \details  With an output thread, the values are copied into a record and
+ *           written in the background
  * \param    int generation
  * \return   \e void
  */
 void Statistics::write_statistics( int generation )
 {
+  if (_writer != NULL)
+  {
+    statistics_record record;
+    record.mean_file                       = &_mean_file;
+    record.sd_file                         = &_sd_file;
+    record.generation                      = generation;
+    record.mean[DMU_STATISTIC]             = _dmu_mean;
+    record.mean[DZ_STATISTIC]              = _dz_mean;
+    record.mean[WMU_STATISTIC]             = _Wmu_mean;
+    record.mean[WZ_STATISTIC]              = _Wz_mean;
+    record.mean[EV_STATISTIC]              = _EV_mean;
+    record.mean[EV_CONTRIBUTION_STATISTIC] = _EV_contribution_mean;
+    record.mean[EV_DOT_PRODUCT_STATISTIC]  = _EV_dot_product_mean;
+    record.mean[R_MU_STATISTIC]            = _r_mu_mean;
+    record.mean[R_SIGMA_STATISTIC]         = _r_sigma_mean;
+    record.mean[R_THETA_STATISTIC]         = _r_theta_mean;
+    record.sd[DMU_STATISTIC]               = _dmu_sd;
+    record.sd[DZ_STATISTIC]                = _dz_sd;
+    record.sd[WMU_STATISTIC]               = _Wmu_sd;
+    record.sd[WZ_STATISTIC]                = _Wz_sd;
+    record.sd[EV_STATISTIC]                = _EV_sd;
+    record.sd[EV_CONTRIBUTION_STATISTIC]   = _EV_contribution_sd;
+    record.sd[EV_DOT_PRODUCT_STATISTIC]    = _EV_dot_product_sd;
+    record.sd[R_MU_STATISTIC]              = _r_mu_sd;
+    record.sd[R_SIGMA_STATISTIC]           = _r_sigma_sd;
+    record.sd[R_THETA_STATISTIC]           = _r_theta_sd;
+    record.lineage                         = _lineage;
+    _writer->push(record);
+    return;
+  }
+  
   /*----------------------------------------------- MEAN VALUES */
   
   _mean_file << generation << " ";
@@ -310,7 +350,15 @@ void Statistics::write_statistics( int generation )
   _mean_file << _EV_dot_product_mean << " ";
   _mean_file << _r_mu_mean << " ";
   _mean_file << _r_sigma_mean << " ";
-  _mean_file << _r_theta_mean << "\n";
+  _mean_file << _r_theta_mean;
+  if (_lineage.enabled)
+  {
+    _mean_file << " " << _lineage.mrca;
+    _mean_file << " " << _lineage.tmrca;
+    _mean_file << " " << _lineage.fixed;
+    _mean_file << " " << _lineage.fixed_beneficial;
+  }
+  _mean_file << "\n";
   
   /*----------------------------------------------- STANDARD DEVIATION VALUES */
   
@@ -364,24 +412,32 @@ void Statistics::reset( void )
 
 /**
  * \brief    Flush statistics files
- * \details  --
+ * \details  The output thread flushes the files itself
  * \param    void
  * \return   \e void
  */
 void Statistics::flush( void )
 {
+  if (_writer != NULL)
+  {
+    return;
+  }
   _mean_file.flush();
   _sd_file.flush();
 }
 
 /**
  * \brief    Close statistics files
- * \details  --
+ * \details  Waits for the records still in flight
  * \param    void
  * \return   \e void
  */
 void Statistics::close( void )
 {
+  if (_writer != NULL)
+  {
+    _writer->drain();
+  }
   _mean_file.close();
   _sd_file.close();
 }
@@ -389,3 +445,4 @@ void Statistics::close( void )
 /*----------------------------
  * PROTECTED METHODS
  *----------------------------*/
+
@@ -32,9 +32,16 @@
 
 #include <iostream>
 #include <fstream>
+#include <sstream>
+#include <string>
 #include <assert.h>
 
+#include "Structs.h"
+#include "StatisticsAccumulator.h"
+#include "StatisticsWriter.h"
 #include "Population.h"
+#include "ScalarPopulation.h"
+#include "Metapopulation.h"
 
 
 class Statistics
@@ -46,6 +53,7 @@ public:
    * CONSTRUCTORS
    *----------------------------*/
   Statistics( void );
+  Statistics( const std::string& suffix );
   Statistics( const Statistics& statistics ) = delete;
   
   /*----------------------------
@@ -66,11 +74,19 @@ public:
    *----------------------------*/
   Statistics& operator=(const Statistics&) = delete;
   
+  inline void set_writer( StatisticsWriter* writer );
+  inline void set_lineage_columns( bool lineage_columns );
+  inline void set_prng_type( prng_type type );
+  
   /*----------------------------
    * PUBLIC METHODS
    *----------------------------*/
   void write_headers( void );
+  void compute_statistics( const StatisticsAccumulator* accumulator );
   void compute_statistics( Population* population );
+  void compute_statistics( ScalarPopulation* population, int replicate );
+  void compute_statistics( Metapopulation* metapopulation );
+  void compute_statistics( const Tree* tree, int generation );
   void write_statistics( int generation );
   void reset( void );
   void flush( void );
@@ -116,10 +132,16 @@ protected:
   double _r_sigma_sd;         /*!< Euclidean size of sigma mutation */
   double _r_theta_sd;         /*!< Euclidean size of theta mutation */
   
+  /*----------------------------------------------- LINEAGE STATISTICS */
+  
+  lineage_statistics _lineage; /*!< MRCA and fixed mutations (extra mean columns) */
+  
   /*----------------------------------------------- STATISTIC FILES */
   
-  std::ofstream _mean_file; /*!< Mean file               */
-  std::ofstream _sd_file;   /*!< Standard deviation file */
+  std::ofstream     _mean_file; /*!< Mean file                                     */
+  std::ofstream     _sd_file;   /*!< Standard deviation file                       */
+  StatisticsWriter* _writer;    /*!< Output thread (NULL to write files directly) */
+  prng_type         _prng_type; /*!< Prng algorithm (written in the file headers)  */
 };
 
 
@@ -175,6 +197,41 @@ inline double Statistics::get_Wz_mean( void ) const
  * SETTERS
  *----------------------------*/
 
+/**
+ * \brief    Set the output thread writing the statistics
+ * \details  --
+ * \param    StatisticsWriter* writer
+ * \return   \e void
+ */
+inline void Statistics::set_writer( StatisticsWriter* writer )
+{
+  _writer = writer;
+}
+
+/**
+ * \brief    Set the lineage columns mode
+ * \details  When true, the MRCA, the time to the MRCA and the number of fixed
+ *           mutations are added to the mean file. Must be set before the
+ *           headers are written
+ * \param    bool lineage_columns
+ * \return   \e void
+ */
+inline void Statistics::set_lineage_columns( bool lineage_columns )
+{
+  _lineage.enabled = lineage_columns;
+}
+
+/**
+ * \brief    Set the prng algorithm
+ * \details  Written in the headers of the statistics files. Must be set
+ *           before the headers are written
+ * \param    prng_type type
+ * \return   \e void
+ */
+inline void Statistics::set_prng_type( prng_type type )
+{
+  _prng_type = type;
+}
 
 
 #endif /* defined(__SigmaFGM__Statistics__) */
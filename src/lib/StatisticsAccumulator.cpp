@@ -0,0 +1,110 @@
+/**
+ * \file      StatisticsAccumulator.cpp
+ * \authors   Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * \date      18-10-2026
+ * \copyright Copyright (C) 2016-2020 Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard. All rights reserved
+ * \license   This project is released under the GNU General Public License
+ * \brief     StatisticsAccumulator class definition
+ */
+
+/***********************************************************************
+ * Copyright (C) 2016-2020
+ * Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * Web: https://github.com/charlesrocabert/SigmaFGM/
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#include "StatisticsAccumulator.h"
+
+
+/*----------------------------
+ * CONSTRUCTORS
+ *----------------------------*/
+
+/**
+ * \brief    Default constructor
+ * \details  --
+ * \param    void
+ * \return   \e void
+ */
+StatisticsAccumulator::StatisticsAccumulator( void )
+{
+  reset();
+}
+
+/*----------------------------
+ * DESTRUCTORS
+ *----------------------------*/
+
+/**
+ * \brief    Destructor
+ * \details  --
+ * \param    void
+ * \return   \e void
+ */
+StatisticsAccumulator::~StatisticsAccumulator( void )
+{
+  /* NOTHING TO DO */
+}
+
+/*----------------------------
+ * PUBLIC METHODS
+ *----------------------------*/
+
+/**
+ * \brief    Reset the means and squared deviations
+ * \details  --
+ * \param    void
+ * \return   \e void
+ */
+void StatisticsAccumulator::reset( void )
+{
+  _count = 0;
+  for (int i = 0; i < NUMBER_OF_STATISTICS; i++)
+  {
+    _mean[i] = 0.0;
+    _m2[i]   = 0.0;
+  }
+}
+
+/**
+ * \brief    Add the individuals of another accumulator
+ * \details  Pairwise combination of Chan et al.: the squared deviations of
+ *           both parts are summed, plus the deviation between both means.
+ *           Merging partial accumulators in a fixed order keeps the result
+ *           independent of the way the work was distributed
+ * \param    const StatisticsAccumulator* accumulator
+ * \return   \e void
+ */
+void StatisticsAccumulator::merge( const StatisticsAccumulator* accumulator )
+{
+  assert(accumulator != NULL);
+  if (accumulator->_count == 0)
+  {
+    return;
+  }
+  double n_a    = (double)_count;
+  double n_b    = (double)accumulator->_count;
+  double n      = n_a+n_b;
+  double weight = n_b/n;
+  double cross  = n_a*n_b/n;
+  for (int i = 0; i < NUMBER_OF_STATISTICS; i++)
+  {
+    double delta  = accumulator->_mean[i]-_mean[i];
+    _mean[i]     += delta*weight;
+    _m2[i]       += accumulator->_m2[i]+delta*delta*cross;
+  }
+  _count += accumulator->_count;
+}
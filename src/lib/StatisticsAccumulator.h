@@ -0,0 +1,187 @@
+/**
+ * \file      StatisticsAccumulator.h
+ * \authors   Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * \date      18-10-2026
+ * \copyright Copyright (C) 2016-2020 Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard. All rights reserved
+ * \license   This project is released under the GNU General Public License
+ * \brief     StatisticsAccumulator class declaration
+ */
+
+/***********************************************************************
+ * Copyright (C) 2016-2020
+ * Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * Web: https://github.com/charlesrocabert/SigmaFGM/
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#ifndef __SigmaFGM__StatisticsAccumulator__
+#define __SigmaFGM__StatisticsAccumulator__
+
+#include <iostream>
+#include <assert.h>
+
+#include "Macros.h"
+#include "Enums.h"
+#include "Individual.h"
+
+
+class StatisticsAccumulator
+{
+  
+public:
+  
+  /*----------------------------
+   * CONSTRUCTORS
+   *----------------------------*/
+  StatisticsAccumulator( void );
+  StatisticsAccumulator( const StatisticsAccumulator& accumulator ) = delete;
+  
+  /*----------------------------
+   * DESTRUCTORS
+   *----------------------------*/
+  ~StatisticsAccumulator( void );
+  
+  /*----------------------------
+   * GETTERS
+   *----------------------------*/
+  inline int    get_count( void ) const;
+  inline double get_mean( statistic variable ) const;
+  inline double get_variance( statistic variable ) const;
+  
+  /*----------------------------
+   * SETTERS
+   *----------------------------*/
+  StatisticsAccumulator& operator=(const StatisticsAccumulator&) = delete;
+  
+  /*----------------------------
+   * PUBLIC METHODS
+   *----------------------------*/
+  void        reset( void );
+  inline void add_individual( const Individual* individual );
+  inline void add_values( const double* values );
+  void        merge( const StatisticsAccumulator* accumulator );
+  
+  /*----------------------------
+   * PUBLIC ATTRIBUTES
+   *----------------------------*/
+  
+protected:
+  
+  /*----------------------------
+   * PROTECTED METHODS
+   *----------------------------*/
+  
+  /*----------------------------
+   * PROTECTED ATTRIBUTES
+   *----------------------------*/
+  int    _count;                      /*!< Number of individuals added                  */
+  double _mean[NUMBER_OF_STATISTICS]; /*!< Means of the variables                       */
+  double _m2[NUMBER_OF_STATISTICS];   /*!< Sums of the squared deviations from the mean */
+};
+
+
+/*----------------------------
+ * GETTERS
+ *----------------------------*/
+
+/**
+ * \brief    Get the number of individuals added
+ * \details  --
+ * \param    void
+ * \return   \e int
+ */
+inline int StatisticsAccumulator::get_count( void ) const
+{
+  return _count;
+}
+
+/**
+ * \brief    Get the mean of a variable
+ * \details  --
+ * \param    statistic variable
+ * \return   \e double
+ */
+inline double StatisticsAccumulator::get_mean( statistic variable ) const
+{
+  return _mean[variable];
+}
+
+/**
+ * \brief    Get the variance of a variable
+ * \details  Population variance (divided by the number of individuals). 0 if
+ *           no individual was added
+ * \param    statistic variable
+ * \return   \e double
+ */
+inline double StatisticsAccumulator::get_variance( statistic variable ) const
+{
+  return (_count > 0 ? _m2[variable]/(double)_count : 0.0);
+}
+
+/*----------------------------
+ * SETTERS
+ *----------------------------*/
+
+/*----------------------------
+ * PUBLIC METHODS
+ *----------------------------*/
+
+/**
+ * \brief    Add the values of one individual
+ * \details  Called right after the fitness of an offspring is computed, while
+ *           the individual is still in cache
+ * \param    const Individual* individual
+ * \return   \e void
+ */
+inline void StatisticsAccumulator::add_individual( const Individual* individual )
+{
+  double values[NUMBER_OF_STATISTICS];
+  values[DMU_STATISTIC]             = individual->get_dmu();
+  values[DZ_STATISTIC]              = individual->get_dz();
+  values[WMU_STATISTIC]             = individual->get_Wmu();
+  values[WZ_STATISTIC]              = individual->get_Wz();
+  values[EV_STATISTIC]              = individual->get_max_Sigma_eigenvalue();
+  values[EV_CONTRIBUTION_STATISTIC] = individual->get_max_Sigma_contribution();
+  values[EV_DOT_PRODUCT_STATISTIC]  = individual->get_max_dot_product();
+  values[R_MU_STATISTIC]            = individual->get_r_mu();
+  values[R_SIGMA_STATISTIC]         = individual->get_r_sigma();
+  values[R_THETA_STATISTIC]         = individual->get_r_theta();
+  add_values(values);
+}
+
+/**
+ * \brief    Add the values of all the variables for one individual
+ * \details  Welford update: the means move towards the new values, and the
+ *           squared deviations are accumulated around the updated means, so
+ *           that the variance never suffers from the cancellation of
+ *           E[x^2]-E[x]^2. The variables share one division, and the loop runs
+ *           over contiguous arrays (vectorized by the compiler)
+ * \param    const double* values
+ * \return   \e void
+ */
+inline void StatisticsAccumulator::add_values( const double* values )
+{
+  _count++;
+  double inverse = 1.0/(double)_count;
+  for (int i = 0; i < NUMBER_OF_STATISTICS; i++)
+  {
+    double delta  = values[i]-_mean[i];
+    _mean[i]     += delta*inverse;
+    _m2[i]       += delta*(values[i]-_mean[i]);
+  }
+}
+
+
+#endif /* defined(__SigmaFGM__StatisticsAccumulator__) */
@@ -0,0 +1,161 @@
+/**
+ * \file      StatisticsWriter.cpp
+ * \authors   Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * \date      18-10-2026
+ * \copyright Copyright (C) 2016-2020 Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard. All rights reserved
+ * \license   This project is released under the GNU General Public License
+ * \brief     StatisticsWriter class definition
+ */
+
+/***********************************************************************
+ * Copyright (C) 2016-2020
+ * Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * Web: https://github.com/charlesrocabert/SigmaFGM/
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#include "StatisticsWriter.h"
+
+
+/*----------------------------
+ * CONSTRUCTORS
+ *----------------------------*/
+
+/**
+ * \brief    Constructor
+ * \details  Starts the output thread. At most capacity records are in flight:
+ *           the simulation blocks when the output falls that far behind
+ * \param    int capacity
+ * \return   \e void
+ */
+StatisticsWriter::StatisticsWriter( int capacity )
+{
+  assert(capacity > 0);
+  _records.resize(capacity);
+  _head   = 0;
+  _count  = 0;
+  _stop   = false;
+  _thread = std::thread(&StatisticsWriter::work, this);
+}
+
+/*----------------------------
+ * DESTRUCTORS
+ *----------------------------*/
+
+/**
+ * \brief    Destructor
+ * \details  Records still in flight are written before the thread stops
+ * \param    void
+ * \return   \e void
+ */
+StatisticsWriter::~StatisticsWriter( void )
+{
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stop = true;
+  }
+  _not_empty.notify_one();
+  _thread.join();
+}
+
+/*----------------------------
+ * PUBLIC METHODS
+ *----------------------------*/
+
+/**
+ * \brief    Queue a record for writing
+ * \details  The record is copied, so the caller can reuse its statistics
+ * \param    const statistics_record& record
+ * \return   \e void
+ */
+void StatisticsWriter::push( const statistics_record& record )
+{
+  std::unique_lock<std::mutex> lock(_mutex);
+  _not_full.wait(lock, [this]{ return _count < (int)_records.size(); });
+  _records[(_head+_count)%_records.size()] = record;
+  _count++;
+  lock.unlock();
+  _not_empty.notify_one();
+}
+
+/**
+ * \brief    Wait until every queued record is written
+ * \details  Must be called before closing the files of the records
+ * \param    void
+ * \return   \e void
+ */
+void StatisticsWriter::drain( void )
+{
+  std::unique_lock<std::mutex> lock(_mutex);
+  _not_full.wait(lock, [this]{ return _count == 0; });
+}
+
+/*----------------------------
+ * PROTECTED METHODS
+ *----------------------------*/
+
+/**
+ * \brief    Output thread loop
+ * \details  The slot of a record is released once the record is written
+ * \param    void
+ * \return   \e void
+ */
+void StatisticsWriter::work( void )
+{
+  std::unique_lock<std::mutex> lock(_mutex);
+  while (true)
+  {
+    _not_empty.wait(lock, [this]{ return _count > 0 || _stop; });
+    if (_count == 0)
+    {
+      return;
+    }
+    const statistics_record& record = _records[_head];
+    lock.unlock();
+    write_record(record);
+    lock.lock();
+    _head = (_head+1)%(int)_records.size();
+    _count--;
+    _not_full.notify_all();
+  }
+}
+
+/**
+ * \brief    Write a record
+ * \details  Same format as Statistics::write_statistics()
+ * \param    const statistics_record& record
+ * \return   \e void
+ */
+void StatisticsWriter::write_record( const statistics_record& record )
+{
+  *record.mean_file << record.generation;
+  *record.sd_file << record.generation;
+  for (int i = 0; i < NUMBER_OF_STATISTICS; i++)
+  {
+    *record.mean_file << " " << record.mean[i];
+    *record.sd_file << " " << record.sd[i];
+  }
+  if (record.lineage.enabled)
+  {
+    *record.mean_file << " " << record.lineage.mrca;
+    *record.mean_file << " " << record.lineage.tmrca;
+    *record.mean_file << " " << record.lineage.fixed;
+    *record.mean_file << " " << record.lineage.fixed_beneficial;
+  }
+  *record.mean_file << "\n";
+  *record.sd_file << "\n";
+  record.mean_file->flush();
+  record.sd_file->flush();
+}
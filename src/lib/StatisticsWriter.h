@@ -0,0 +1,112 @@
+/**
+ * \file      StatisticsWriter.h
+ * \authors   Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * \date      18-10-2026
+ * \copyright Copyright (C) 2016-2020 Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard. All rights reserved
+ * \license   This project is released under the GNU General Public License
+ * \brief     StatisticsWriter class declaration
+ */
+
+/***********************************************************************
+ * Copyright (C) 2016-2020
+ * Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * Web: https://github.com/charlesrocabert/SigmaFGM/
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#ifndef __SigmaFGM__StatisticsWriter__
+#define __SigmaFGM__StatisticsWriter__
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <assert.h>
+
+#include "Macros.h"
+#include "Enums.h"
+#include "Structs.h"
+
+
+class StatisticsWriter
+{
+  
+public:
+  
+  /*----------------------------
+   * CONSTRUCTORS
+   *----------------------------*/
+  StatisticsWriter( void ) = delete;
+  StatisticsWriter( int capacity );
+  StatisticsWriter( const StatisticsWriter& writer ) = delete;
+  
+  /*----------------------------
+   * DESTRUCTORS
+   *----------------------------*/
+  ~StatisticsWriter( void );
+  
+  /*----------------------------
+   * GETTERS
+   *----------------------------*/
+  
+  /*----------------------------
+   * SETTERS
+   *----------------------------*/
+  StatisticsWriter& operator=(const StatisticsWriter&) = delete;
+  
+  /*----------------------------
+   * PUBLIC METHODS
+   *----------------------------*/
+  void push( const statistics_record& record );
+  void drain( void );
+  
+  /*----------------------------
+   * PUBLIC ATTRIBUTES
+   *----------------------------*/
+  
+protected:
+  
+  /*----------------------------
+   * PROTECTED METHODS
+   *----------------------------*/
+  void work( void );
+  void write_record( const statistics_record& record );
+  
+  /*----------------------------
+   * PROTECTED ATTRIBUTES
+   *----------------------------*/
+  std::vector<statistics_record> _records;   /*!< Ring buffer of records waiting to be written */
+  int                            _head;      /*!< Position of the oldest record                */
+  int                            _count;     /*!< Number of records in flight                  */
+  bool                           _stop;      /*!< Indicates if the thread must stop            */
+  std::mutex                     _mutex;     /*!< Mutex protecting the ring buffer             */
+  std::condition_variable        _not_empty; /*!< Signals a new record to the output thread    */
+  std::condition_variable        _not_full;  /*!< Signals a free slot to the producer          */
+  std::thread                    _thread;    /*!< Output thread                                */
+};
+
+
+/*----------------------------
+ * GETTERS
+ *----------------------------*/
+
+/*----------------------------
+ * SETTERS
+ *----------------------------*/
+
+
+#endif /* defined(__SigmaFGM__StatisticsWriter__) */
@@ -31,9 +31,235 @@
 #define __SigmaFGM__Structs__
 
 #include <iostream>
+#include <fstream>
+#include <cstdint>
 
 #include "Macros.h"
 #include "Enums.h"
 
 
+/**
+ * \brief   Numeric kernels table
+ * \details Pointers to one instruction set variant of the numeric kernels
+ */
+struct kernel_table
+{
+  void   (*phenotype)( double* z, const double* mu, const double* sigma, const double* gaussian, int n );   /*!< z = mu+sigma*gaussian               */
+  void   (*distance)( double* d, const double* x, double x_opt, int n );                                    /*!< d = |x-x_opt|                       */
+  void   (*fitness)( double* W, const double* d, double alpha, double beta, double Q, int n );              /*!< W = (1-beta)exp(-alpha*d^Q)+beta    */
+  double (*sum)( const double* x, int n );                                                                  /*!< Sum of x                            */
+  void   (*box_muller)( double* gaussian, const double* uniform, int n );                                   /*!< N(0,1) draws from uniform draws     */
+};
+
+
+/**
+ * \brief   Philox state
+ * \details State of a Philox4x32-10 counter-based generator
+ */
+struct philox_state
+{
+  unsigned int key[2];     /*!< Key (seed)                                   */
+  unsigned int counter[4]; /*!< Counter (block index and stream identifiers) */
+  unsigned int output[4];  /*!< Output of the current block                  */
+  int          position;   /*!< Next output word of the current block        */
+};
+
+/**
+ * \brief   Xoshiro state
+ * \details State of a xoshiro256++ generator
+ */
+struct xoshiro_state
+{
+  uint64_t s[4]; /*!< State words */
+};
+
+/* GCC/Clang extension, marked as such so that pedantic builds accept it */
+__extension__ typedef unsigned __int128 pcg_uint128;
+
+/**
+ * \brief   PCG state
+ * \details State of a PCG64 generator (128-bit LCG)
+ */
+struct pcg_state
+{
+  pcg_uint128 state; /*!< LCG state */
+};
+
+/**
+ * \brief   Lineage tree node
+ * \details Links and state of one slot of the lineage tree arena. Links are
+ *          indices into the arena, NO_NODE when absent. Children form a
+ *          doubly-linked list through the sibling links, and are counted
+ */
+struct tree_node
+{
+  unsigned int parent;             /*!< Parent node                               */
+  unsigned int first_child;        /*!< First child node                          */
+  unsigned int next_sibling;       /*!< Next child of the parent                  */
+  unsigned int previous_sibling;   /*!< Previous child of the parent              */
+  unsigned int number_of_children; /*!< Number of children (reference count)      */
+  node_class   type;               /*!< Node class (master root, root or normal)  */
+  node_state   state;              /*!< Node state (dead or alive)                */
+  bool         in_use;             /*!< Indicates if the slot holds a node        */
+  bool         exported;           /*!< Written in the genealogy tables           */
+  bool         fixed;              /*!< Ancestor of the whole living population   */
+};
+
+/**
+ * \brief   Lineage record
+ * \details Values of one individual, recorded along lineages
+ */
+struct lineage_record
+{
+  unsigned long long int identifier;     /*!< Individual's identifier                 */
+  int                    generation;     /*!< Individual's generation                 */
+  double                 dmu;            /*!< Euclidean distance d(mu)                */
+  double                 dz;             /*!< Euclidean distance d(z)                 */
+  double                 Wmu;            /*!< Fitness W(mu)                           */
+  double                 Wz;             /*!< Fitness W(z)                            */
+  double                 EV;             /*!< Maximum Sigma eigenvalue                */
+  double                 EV_contrib;     /*!< Eigenvalue contribution to the variance */
+  double                 EV_dot_product; /*!< Dot product of eigenvector and optimum  */
+  double                 r_mu;           /*!< Euclidean size of mu mutation           */
+  double                 r_sigma;        /*!< Euclidean size of sigma mutation        */
+  double                 r_theta;        /*!< Euclidean size of theta mutation        */
+  unsigned int           mutations;      /*!< Mutations on the branch from the parent */
+  unsigned int           beneficial;     /*!< Beneficial mutations on this branch     */
+};
+
+/**
+ * \brief   Lineage log entry
+ * \details Ancestry of one record of the lineage log
+ */
+struct lineage_log_entry
+{
+  unsigned int parent;     /*!< Parent entry (NO_NODE for a root)              */
+  unsigned int references; /*!< Child entries, plus one while alive (refcount) */
+  bool         alive;      /*!< Indicates if the individual is alive           */
+  bool         in_use;     /*!< Indicates if the slot holds an entry           */
+};
+
+/**
+ * \brief   Genealogy table header
+ * \details First bytes of a genealogy table file
+ */
+struct genealogy_header
+{
+  char     magic[8]; /*!< Table name (SFGMNODE or SFGMEDGE) */
+  uint32_t version;  /*!< Format version                   */
+  uint32_t row_size; /*!< Size of a row in bytes           */
+};
+
+/**
+ * \brief   Genealogy node row
+ * \details One node of the genealogy tables (fixed-size, no padding)
+ */
+struct genealogy_node
+{
+  uint64_t identifier;     /*!< Individual's identifier                 */
+  int32_t  generation;     /*!< Birth generation                        */
+  uint32_t flags;          /*!< Node flags (GENEALOGY_SAMPLE)           */
+  double   dmu;            /*!< Euclidean distance d(mu)                */
+  double   dz;             /*!< Euclidean distance d(z)                 */
+  double   Wmu;            /*!< Fitness W(mu)                           */
+  double   Wz;             /*!< Fitness W(z)                            */
+  double   EV;             /*!< Maximum Sigma eigenvalue                */
+  double   EV_contrib;     /*!< Eigenvalue contribution to the variance */
+  double   EV_dot_product; /*!< Dot product of eigenvector and optimum  */
+  double   r_mu;           /*!< Euclidean size of mu mutation           */
+  double   r_sigma;        /*!< Euclidean size of sigma mutation        */
+  double   r_theta;        /*!< Euclidean size of theta mutation        */
+};
+
+/**
+ * \brief   Genealogy edge row
+ * \details One parent-child link of the genealogy tables
+ */
+struct genealogy_edge
+{
+  uint64_t parent; /*!< Parent's identifier */
+  uint64_t child;  /*!< Child's identifier  */
+};
+
+/**
+ * \brief   Lineage statistics
+ * \details MRCA of the living population and fixed mutations, written as
+ *          extra columns of the mean file with lineage tracking
+ */
+struct lineage_statistics
+{
+  bool                   enabled;          /*!< Indicates if the columns are written       */
+  unsigned long long int mrca;             /*!< MRCA's identifier (0 if not coalesced)     */
+  int                    tmrca;            /*!< Time to the MRCA (-1 if not coalesced)     */
+  unsigned long long int fixed;            /*!< Mutations fixed since the start of the run */
+  unsigned long long int fixed_beneficial; /*!< Beneficial mutations among them            */
+};
+
+/**
+ * \brief   Mutation event row
+ * \details One event of the mutation log (fixed-size, no padding)
+ */
+struct mutation_event
+{
+  uint64_t identifier; /*!< Event identifier (from 1)             */
+  uint64_t individual; /*!< Mutant's identifier                   */
+  uint64_t parent;     /*!< Parent's identifier                   */
+  int32_t  generation; /*!< Birth generation of the mutant        */
+  uint32_t components; /*!< Mutated components (MUTATION_MU, ...) */
+  double   r_mu;       /*!< Euclidean size of mu mutation         */
+  double   r_sigma;    /*!< Euclidean size of sigma mutation      */
+  double   r_theta;    /*!< Euclidean size of theta mutation      */
+  double   Wmu_before; /*!< Parent's fitness W(mu)                */
+  double   Wmu_after;  /*!< Mutant's fitness W(mu)                */
+  double   Wz_before;  /*!< Parent's fitness W(z)                 */
+  double   Wz_after;   /*!< Mutant's fitness W(z)                 */
+};
+
+/**
+ * \brief   Mutation fate row
+ * \details Fixation or loss of one event of the mutation log
+ */
+struct mutation_fate
+{
+  uint64_t identifier; /*!< Event identifier                   */
+  int32_t  generation; /*!< Generation of the fixation or loss */
+  uint32_t fate;       /*!< MUTATION_FIXED or MUTATION_LOST    */
+};
+
+/**
+ * \brief   Mutation origin
+ * \details Values of a segregating mutation, kept until its fate is known
+ */
+struct mutation_origin
+{
+  int generation; /*!< Birth generation of the mutant */
+  int bin;        /*!< Effect size bin                */
+};
+
+/**
+ * \brief   Fixation statistics
+ * \details Fates of the mutations of one effect size bin
+ */
+struct fixation_statistics
+{
+  unsigned long long int events;        /*!< Mutation events           */
+  unsigned long long int fixed;         /*!< Fixed mutations           */
+  unsigned long long int lost;          /*!< Lost mutations            */
+  double                 fixation_time; /*!< Sum of the fixation times */
+};
+
+/**
+ * \brief   Statistics record
+ * \details One line of statistics waiting to be written by the output thread
+ */
+struct statistics_record
+{
+  std::ofstream*     mean_file;                  /*!< Mean file               */
+  std::ofstream*     sd_file;                    /*!< Standard deviation file */
+  int                generation;                 /*!< Generation              */
+  double             mean[NUMBER_OF_STATISTICS]; /*!< Mean values             */
+  double             sd[NUMBER_OF_STATISTICS];   /*!< Standard deviations     */
+  lineage_statistics lineage;                    /*!< Lineage statistics      */
+};
+
 #endif /* defined(__SigmaFGM__Structs__) */
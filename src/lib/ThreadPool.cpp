@@ -0,0 +1,278 @@
+
+/**
+ * \file      ThreadPool.cpp
+ * \authors   Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * \date      18-10-2026
+ * \copyright Copyright (C) 2016-2020 Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard. All rights reserved
+ * \license   This project is released under the GNU General Public License
+ * \brief     ThreadPool class definition
+ */
+
+/***********************************************************************
+ * Copyright (C) 2016-2020
+ * Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * Web: https://github.com/charlesrocabert/SigmaFGM/
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#include "ThreadPool.h"
+
+
+/*----------------------------
+ * CONSTRUCTORS
+ *----------------------------*/
+
+/**
+ * \brief    Constructor
+ * \details  The calling thread takes part in each job, so number_of_threads-1
+ *           worker threads are created. When threads are pinned, thread t
+ *           (the calling thread being thread 0) is bound to the t-th core
+ *           allowed to the process. The process affinity mask is read once,
+ *           before any thread is pinned, since threads inherit the mask of
+ *           their creator
+ * \param    int number_of_threads
+ * \param    bool pin_threads
+ * \return   \e void
+ */
+ThreadPool::ThreadPool( int number_of_threads, bool pin_threads )
+{
+  assert(number_of_threads > 0);
+  
+  /*----------------------------------------------- THREADS */
+  
+  _number_of_threads = number_of_threads;
+  _pin_threads       = pin_threads;
+  _stop              = false;
+  
+  /*----------------------------------------------- CURRENT JOB */
+  
+  _task            = NULL;
+  _number_of_tasks = 0;
+  _sharded         = false;
+  _job             = 0;
+  _next_task       = 0;
+  _busy_workers    = 0;
+  
+  /*----------------------------------------------- CORES */
+  
+#ifdef __linux__
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (_pin_threads && sched_getaffinity(0, sizeof(cpu_set_t), &allowed) == 0)
+  {
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+    {
+      if (CPU_ISSET(cpu, &allowed))
+      {
+        _cores.push_back(cpu);
+      }
+    }
+  }
+#endif
+  
+  /*----------------------------------------------- WORKERS */
+  
+  for (int i = 1; i < _number_of_threads; i++)
+  {
+    _workers.push_back(std::thread(&ThreadPool::work, this, i));
+  }
+  pin(0);
+}
+
+/*----------------------------
+ * DESTRUCTORS
+ *----------------------------*/
+
+/**
+ * \brief    Destructor
+ * \details  --
+ * \param    void
+ * \return   \e void
+ */
+ThreadPool::~ThreadPool( void )
+{
+  {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _stop = true;
+  }
+  _job_ready.notify_all();
+  for (size_t i = 0; i < _workers.size(); i++)
+  {
+    _workers[i].join();
+  }
+  _workers.clear();
+  _task = NULL;
+}
+
+/*----------------------------
+ * PUBLIC METHODS
+ *----------------------------*/
+
+/**
+ * \brief    Run task(0), ..., task(number_of_tasks-1) on the pool
+ * \details  Tasks are handed out dynamically, so they must not depend on
+ *           each other nor on the thread running them. The call returns
+ *           when all the tasks are done
+ * \param    int number_of_tasks
+ * \param    const std::function<void(int)>& task
+ * \return   \e void
+ */
+void ThreadPool::run( int number_of_tasks, const std::function<void(int)>& task )
+{
+  start_job(number_of_tasks, task, false);
+}
+
+/**
+ * \brief    Run task(0), ..., task(number_of_tasks-1) on the pool, by shards
+ * \details  Thread t always runs the same contiguous block of tasks for a
+ *           given number of tasks. Memory first touched by a task thus stays
+ *           local to the thread (and NUMA node) running it in later jobs
+ * \param    int number_of_tasks
+ * \param    const std::function<void(int)>& task
+ * \return   \e void
+ */
+void ThreadPool::run_sharded( int number_of_tasks, const std::function<void(int)>& task )
+{
+  start_job(number_of_tasks, task, true);
+}
+
+/*----------------------------
+ * PROTECTED METHODS
+ *----------------------------*/
+
+/**
+ * \brief    Publish a job, take part in it and wait for its end
+ * \details  --
+ * \param    int number_of_tasks
+ * \param    const std::function<void(int)>& task
+ * \param    bool sharded
+ * \return   \e void
+ */
+void ThreadPool::start_job( int number_of_tasks, const std::function<void(int)>& task, bool sharded )
+{
+  assert(number_of_tasks >= 0);
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 1) Publish the job                    */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _task            = &task;
+    _number_of_tasks = number_of_tasks;
+    _sharded         = sharded;
+    _next_task       = 0;
+    _busy_workers    = (int)_workers.size();
+    _job++;
+  }
+  _job_ready.notify_all();
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 2) Take part in the job               */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  execute_tasks(0);
+  
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  /* 3) Wait for the workers               */
+  /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+  std::unique_lock<std::mutex> lock(_mutex);
+  while (_busy_workers > 0)
+  {
+    _job_done.wait(lock);
+  }
+  _task = NULL;
+}
+
+/**
+ * \brief    Worker thread loop
+ * \details  --
+ * \param    int thread_index
+ * \return   \e void
+ */
+void ThreadPool::work( int thread_index )
+{
+  pin(thread_index);
+  unsigned long long int last_job = 0;
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(_mutex);
+      while (!_stop && _job == last_job)
+      {
+        _job_ready.wait(lock);
+      }
+      if (_stop)
+      {
+        return;
+      }
+      last_job = _job;
+    }
+    execute_tasks(thread_index);
+    {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _busy_workers--;
+    }
+    _job_done.notify_one();
+  }
+}
+
+/**
+ * \brief    Execute the tasks of the current job until none is left
+ * \details  In a sharded job, the thread only runs its own block of tasks
+ * \param    int thread_index
+ * \return   \e void
+ */
+void ThreadPool::execute_tasks( int thread_index )
+{
+  if (_sharded)
+  {
+    long long int first = (long long int)thread_index*_number_of_tasks/_number_of_threads;
+    long long int last  = (long long int)(thread_index+1)*_number_of_tasks/_number_of_threads;
+    for (long long int i = first; i < last; i++)
+    {
+      (*_task)((int)i);
+    }
+    return;
+  }
+  int i = _next_task.fetch_add(1);
+  while (i < _number_of_tasks)
+  {
+    (*_task)(i);
+    i = _next_task.fetch_add(1);
+  }
+}
+
+/**
+ * \brief    Pin the calling thread to a core
+ * \details  Thread t is bound to the t-th core of the process affinity mask
+ *           (modulo its size), as read by the constructor. Does nothing when
+ *           pinning is disabled or on systems without thread affinity
+ * \param    int thread_index
+ * \return   \e void
+ */
+void ThreadPool::pin( int thread_index )
+{
+  if (!_pin_threads || _cores.empty())
+  {
+    return;
+  }
+#ifdef __linux__
+  cpu_set_t core;
+  CPU_ZERO(&core);
+  CPU_SET(_cores[(size_t)thread_index%_cores.size()], &core);
+  pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &core);
+#else
+  (void)thread_index;
+#endif
+}
@@ -0,0 +1,143 @@
+
+/**
+ * \file      ThreadPool.h
+ * \authors   Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * \date      18-10-2026
+ * \copyright Copyright (C) 2016-2020 Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard. All rights reserved
+ * \license   This project is released under the GNU General Public License
+ * \brief     ThreadPool class declaration
+ */
+
+/***********************************************************************
+ * Copyright (C) 2016-2020
+ * Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * Web: https://github.com/charlesrocabert/SigmaFGM/
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#ifndef __SigmaFGM__ThreadPool__
+#define __SigmaFGM__ThreadPool__
+
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <assert.h>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "Macros.h"
+#include "Enums.h"
+
+
+class ThreadPool
+{
+  
+public:
+  
+  /*----------------------------
+   * CONSTRUCTORS
+   *----------------------------*/
+  ThreadPool( void ) = delete;
+  ThreadPool( int number_of_threads, bool pin_threads );
+  ThreadPool( const ThreadPool& pool ) = delete;
+  
+  /*----------------------------
+   * DESTRUCTORS
+   *----------------------------*/
+  ~ThreadPool( void );
+  
+  /*----------------------------
+   * GETTERS
+   *----------------------------*/
+  inline int get_number_of_threads( void ) const;
+  
+  /*----------------------------
+   * SETTERS
+   *----------------------------*/
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  
+  /*----------------------------
+   * PUBLIC METHODS
+   *----------------------------*/
+  void run( int number_of_tasks, const std::function<void(int)>& task );
+  void run_sharded( int number_of_tasks, const std::function<void(int)>& task );
+  
+  /*----------------------------
+   * PUBLIC ATTRIBUTES
+   *----------------------------*/
+  
+protected:
+  
+  /*----------------------------
+   * PROTECTED METHODS
+   *----------------------------*/
+  void start_job( int number_of_tasks, const std::function<void(int)>& task, bool sharded );
+  void work( int thread_index );
+  void execute_tasks( int thread_index );
+  void pin( int thread_index );
+  
+  /*----------------------------
+   * PROTECTED ATTRIBUTES
+   *----------------------------*/
+  
+  /*----------------------------------------------- THREADS */
+  
+  int                      _number_of_threads; /*!< Number of threads (including the calling thread) */
+  bool                     _pin_threads;       /*!< Indicates if threads are pinned to cores         */
+  std::vector<int>         _cores;             /*!< Cores allowed to the process (if pinned)         */
+  std::vector<std::thread> _workers;           /*!< Worker threads                                   */
+  std::mutex               _mutex;             /*!< Mutex protecting the job state                   */
+  std::condition_variable  _job_ready;         /*!< Signals a new job to the workers                 */
+  std::condition_variable  _job_done;          /*!< Signals the end of a job to the calling thread   */
+  bool                     _stop;              /*!< Indicates if the workers must stop               */
+  
+  /*----------------------------------------------- CURRENT JOB */
+  
+  const std::function<void(int)>* _task;            /*!< Task of the current job                    */
+  int                             _number_of_tasks; /*!< Number of tasks of the current job         */
+  bool                            _sharded;         /*!< Tasks are bound to threads by blocks       */
+  unsigned long long int          _job;             /*!< Current job identifier                     */
+  std::atomic<int>                _next_task;       /*!< Next task to execute                       */
+  int                             _busy_workers;    /*!< Number of workers still on the current job */
+};
+
+
+/*----------------------------
+ * GETTERS
+ *----------------------------*/
+
+/**
+ * \brief    Get the number of threads
+ * \details  --
+ * \param    void
+ * \return   \e int
+ */
+inline int ThreadPool::get_number_of_threads( void ) const
+{
+  return _number_of_threads;
+}
+
+/*----------------------------
+ * SETTERS
+ *----------------------------*/
+
+
+#endif /* defined(__SigmaFGM__ThreadPool__) */
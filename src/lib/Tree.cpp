@@ -35,17 +35,30 @@
  *----------------------------*/
 
 /**
- * \brief    Default constructor
- * \details  The tree starts with one node called the master root
- * \param    --
+ * \brief    Constructor
+ * \details  The tree starts with one node called the master root, in slot 0.
+ *           If collapse_unary is true, dead nodes left with a single child
+ *           are removed, so that only the coalescence points of the living
+ *           lineages are kept
+ * \param    bool collapse_unary
  * \return   \e void
  */
-Tree::Tree( void )
+Tree::Tree( bool collapse_unary )
 {
-  _node_map.clear();
-  _iterator         = _node_map.begin();
-  Node* master_root = new Node(0, 0);
-  _node_map[0]      = master_root;
+  _nodes.clear();
+  _records.clear();
+  _free_nodes.clear();
+  _number_of_nodes  = 0;
+  _collapse_unary   = collapse_unary;
+  _mrca             = 0;
+  _fixed            = 0;
+  _fixed_beneficial = 0;
+  _mutation_log     = NULL;
+  _index_is_valid   = false;
+  unsigned int master_root = new_node();
+  assert(master_root == 0);
+  _nodes[master_root].type  = MASTER_ROOT;
+  _nodes[master_root].state = DEAD;
 }
 
 /*----------------------------
@@ -60,13 +73,36 @@ Tree::Tree( void )
  */
 Tree::~Tree( void )
 {
-  _iterator = _node_map.begin();
-  for (_iterator = _node_map.begin(); _iterator != _node_map.end(); ++_iterator)
-  {
-    delete _iterator->second;
-    _iterator->second = NULL;
-  }
-  _node_map.clear();
+  _nodes.clear();
+  _records.clear();
+  _free_nodes.clear();
+  _preorder.clear();
+  _first_rank.clear();
+  _last_rank.clear();
+  _alive_prefix.clear();
+  _Wz_prefix.clear();
+  _stack.clear();
+  _mutation_log = NULL;
+  _events.clear();
+}
+
+/*----------------------------
+ * SETTERS
+ *----------------------------*/
+
+/**
+ * \brief    Set the mutation log
+ * \details  Each mutant node then records its event, whose fixation or loss
+ *           is reported to the log. The log requires the full tree: unary
+ *           nodes must not be collapsed, and roots must not be added later
+ * \param    MutationLog* mutation_log
+ * \return   \e void
+ */
+void Tree::set_mutation_log( MutationLog* mutation_log )
+{
+  assert(!_collapse_unary);
+  _mutation_log = mutation_log;
+  _events.assign(_nodes.size(), 0);
 }
 
 /*----------------------------
@@ -75,39 +111,35 @@ Tree::~Tree( void )
 
 /**
  * \brief    Add a root to the tree
- * \details  --
+ * \details  The individual records its node index. Roots added after the
+ *           start (focal sample) do not descend from the last MRCA, so the
+ *           search starts again from the master root
  * \param    Individual* individual
  * \return   \e void
  */
 void Tree::add_root( Individual* individual )
 {
   /*-----------------------------*/
-  /* 1) Get the master root      */
-  /*-----------------------------*/
-  Node* master_root = _node_map[0];
-  
-  /*-----------------------------*/
-  /* 2) Create the node          */
+  /* 1) Create the node          */
   /*-----------------------------*/
-  Node* node = new Node(individual);
+  unsigned int node = new_node();
+  record_individual(_records[node], individual);
   
   /*-----------------------------*/
-  /* 3) Update nodes attributes  */
-  /*-----------------------------*/
-  node->set_root();
-  node->set_parent(master_root);
-  master_root->add_child(node);
-  
+  /* 2) Update nodes attributes  */
   /*-----------------------------*/
-  /* 4) Add the node to the tree */
-  /*-----------------------------*/
-  assert(_node_map.find(node->get_identifier()) == _node_map.end());
-  _node_map[node->get_identifier()] = node;
+  _nodes[node].type = ROOT;
+  attach_child(0, node);
+  individual->set_node(node);
+  _mrca = 0;
 }
 
 /**
  * \brief    Add a reproduction event
- * \details  --
+ * \details  The child records its node index. The parent stays alive until
+ *           its death event. A mu mutation increasing W(mu) is beneficial
+ *           (sigma and theta mutations leave W(mu) unchanged). A mutant child
+ *           is appended to the mutation log if any
  * \param    Individual* parent
  * \param    Individual* child
  * \return   \e void
@@ -117,124 +149,383 @@ void Tree::add_reproduction_event( Individual* parent, Individual* child )
   /*---------------------------------*/
   /* 1) Get parental node            */
   /*---------------------------------*/
-  assert(_node_map.find(parent->get_identifier()) != _node_map.end());
-  Node* parent_node = _node_map[parent->get_identifier()];
-  parent_node->set_dead();
+  unsigned int parent_node = parent->get_node();
+  assert(parent_node < _nodes.size());
+  assert(_nodes[parent_node].in_use);
   
   /*---------------------------------*/
   /* 2) Create child node            */
   /*---------------------------------*/
-  Node* child_node = new Node(child);
-  
-  /*---------------------------------*/
-  /* 3) Update child node attributes */
-  /*---------------------------------*/
-  child_node->set_parent(parent_node);
-  parent_node->add_child(child_node);
+  unsigned int child_node = new_node();
+  record_individual(_records[child_node], child);
+  if (_records[child_node].r_mu > 0.0 && _records[child_node].Wmu > _records[parent_node].Wmu)
+  {
+    _records[child_node].beneficial = 1;
+  }
+  if (_mutation_log != NULL && _records[child_node].mutations > 0)
+  {
+    _events[child_node] = _mutation_log->add_event(_records[parent_node], _records[child_node]);
+  }
   
   /*---------------------------------*/
-  /* 4) Add child node to the tree   */
+  /* 3) Link both nodes              */
   /*---------------------------------*/
-  _node_map[child_node->get_identifier()] = child_node;
+  attach_child(parent_node, child_node);
+  child->set_node(child_node);
+}
+
+/**
+ * \brief    Add a death event
+ * \details  The node is kept as long as it has living descendants: a node
+ *           without children is released at once, and the release cascades
+ *           to the dead ancestors left without children. The cost is
+ *           proportional to the number of released nodes
+ * \param    Individual* individual
+ * \return   \e void
+ */
+void Tree::add_death_event( Individual* individual )
+{
+  unsigned int node = individual->get_node();
+  assert(node < _nodes.size());
+  assert(_nodes[node].in_use);
+  assert(_nodes[node].state == ALIVE);
+  _nodes[node].state = DEAD;
+  _index_is_valid    = false;
+  individual->set_node(NO_NODE);
+  release_dead_ancestors(node);
 }
 
 /**
  * \brief    Delete a node and remove all links
- * \details  --
- * \param    unsigned long long int node_identifier
+ * \details  The children of the node are given to its parent, and become
+ *           roots if the parent is the master root. The mutations of the node
+ *           are added to the branch of each child, unless they are fixed
+ * \param    unsigned int node
  * \return   \e void
  */
-void Tree::delete_node( unsigned long long int node_identifier )
+void Tree::delete_node( unsigned int node )
 {
-  assert(_node_map.find(node_identifier) != _node_map.end());
-  Node* node = _node_map[node_identifier];
-  assert(node->get_identifier() == node_identifier);
-  assert(!node->isAlive());
+  assert(node > 0);
+  assert(node < _nodes.size());
+  assert(_nodes[node].in_use);
+  assert(_nodes[node].state == DEAD);
+  unsigned int parent = _nodes[node].parent;
   
   /*----------------------------------*/
   /* 1) Update parental children list */
   /*----------------------------------*/
-  node->get_parent()->replace_children(node);
+  detach_child(node);
   
   /*-----------------------------------*/
   /* 2) Set the new parent of children */
   /*-----------------------------------*/
-  for (int i = 0; i < node->get_parent()->get_number_of_children(); i++)
+  unsigned int child = _nodes[node].first_child;
+  while (child != NO_NODE)
   {
-    node->get_parent()->get_child(i)->set_parent(node->get_parent());
+    unsigned int next = _nodes[child].next_sibling;
+    _nodes[child].parent = NO_NODE;
+    attach_child(parent, child);
+    if (!_nodes[node].fixed)
+    {
+      _records[child].mutations  += _records[node].mutations;
+      _records[child].beneficial += _records[node].beneficial;
+    }
+    if (parent == 0)
+    {
+      _nodes[child].type = ROOT;
+    }
+    child = next;
   }
+  _nodes[node].first_child        = NO_NODE;
+  _nodes[node].number_of_children = 0;
   
   /*----------------------------------*/
   /* 3) Delete node                   */
   /*----------------------------------*/
-  delete _node_map[node_identifier];
-  _node_map[node_identifier] = NULL;
-  _node_map.erase(node_identifier);
+  release_node(node);
 }
 
 /**
- * \brief    Prune the tree
- * \details  Remove all dead branches
- * \param    void
+ * \brief    List the descendants of a node
+ * \details  The node and its descendants, in depth-first preorder. The
+ *           subtree index is rebuilt first if the tree changed
+ * \param    unsigned int node
+ * \param    std::vector<unsigned int>* descendants
  * \return   \e void
  */
-void Tree::prune()
+void Tree::get_descendants( unsigned int node, std::vector<unsigned int>* descendants )
 {
-  untag_tree();
-  
-  /*-------------------------------------*/
-  /* 1) Tag alive cells lineage          */
-  /*-------------------------------------*/
-  for (_iterator = _node_map.begin(); _iterator != _node_map.end(); ++_iterator)
+  assert(node < _nodes.size());
+  assert(_nodes[node].in_use);
+  build_index();
+  descendants->assign(_preorder.begin()+_first_rank[node], _preorder.begin()+_last_rank[node]+1);
+}
+
+/**
+ * \brief    Check if a node descends from another one
+ * \details  A node descends from itself. O(1) once the index is built
+ * \param    unsigned int node
+ * \param    unsigned int ancestor
+ * \return   \e bool
+ */
+bool Tree::is_descendant( unsigned int node, unsigned int ancestor )
+{
+  assert(_nodes[node].in_use);
+  assert(_nodes[ancestor].in_use);
+  build_index();
+  return (_first_rank[ancestor] <= _first_rank[node] && _first_rank[node] <= _last_rank[ancestor]);
+}
+
+/**
+ * \brief    Get the number of nodes of a clade
+ * \details  The node and its descendants, dead or alive. O(1) once the index
+ *           is built
+ * \param    unsigned int node
+ * \return   \e unsigned int
+ */
+unsigned int Tree::get_clade_size( unsigned int node )
+{
+  assert(_nodes[node].in_use);
+  build_index();
+  return _last_rank[node]-_first_rank[node]+1;
+}
+
+/**
+ * \brief    Get the number of living individuals of a clade
+ * \details  O(1) once the index is built
+ * \param    unsigned int node
+ * \return   \e unsigned int
+ */
+unsigned int Tree::get_clade_population_size( unsigned int node )
+{
+  assert(_nodes[node].in_use);
+  build_index();
+  return _alive_prefix[_last_rank[node]+1]-_alive_prefix[_first_rank[node]];
+}
+
+/**
+ * \brief    Get the mean fitness W(z) of the living individuals of a clade
+ * \details  0 if the clade has no living individual. The difference of two
+ *           prefix sums loses the precision of small clades in large trees,
+ *           so clades of at most CLADE_DIRECT_SUM nodes are summed directly
+ *           over their ranks. O(1) once the index is built
+ * \param    unsigned int node
+ * \return   \e double
+ */
+double Tree::get_clade_mean_fitness( unsigned int node )
+{
+  unsigned int population_size = get_clade_population_size(node);
+  if (population_size == 0)
+  {
+    return 0.0;
+  }
+  if (get_clade_size(node) <= CLADE_DIRECT_SUM)
   {
-    assert(_iterator->first == _iterator->second->get_identifier());
-    if (_iterator->second->isAlive())
+    double Wz_sum = 0.0;
+    for (unsigned int rank = _first_rank[node]; rank <= _last_rank[node]; rank++)
     {
-      _iterator->second->tag_lineage();
+      if (_nodes[_preorder[rank]].state == ALIVE)
+      {
+        Wz_sum += _records[_preorder[rank]].Wz;
+      }
     }
+    return Wz_sum/(double)population_size;
   }
-  
-  /*-------------------------------------*/
-  /* 2) Build the list of untagged nodes */
-  /*-------------------------------------*/
-  std::vector<unsigned long long int> remove_list;
-  for (_iterator = _node_map.begin(); _iterator != _node_map.end(); ++_iterator)
+  return (_Wz_prefix[_last_rank[node]+1]-_Wz_prefix[_first_rank[node]])/(double)population_size;
+}
+
+/**
+ * \brief    Update the most recent common ancestor of the living population
+ * \details  Every living individual descends from the previous MRCA, so the
+ *           search walks down from it while nodes are dead with a single
+ *           child. The nodes passed are fixed: the mutations on their branch
+ *           are counted once, and their events are reported to the mutation
+ *           log if any. The cost is proportional to the progress of the MRCA
+ *           since the last call
+ * \param    void
+ * \return   \e void
+ */
+void Tree::update_mrca( void )
+{
+  unsigned int node = _mrca;
+  while (_nodes[node].number_of_children == 1 && (node == 0 || _nodes[node].state == DEAD))
   {
-    if (!_iterator->second->isTagged() && !_iterator->second->isMasterRoot())
+    node = _nodes[node].first_child;
+    if (!_nodes[node].fixed)
     {
-      remove_list.push_back(_iterator->first);
+      _nodes[node].fixed  = true;
+      _fixed             += _records[node].mutations;
+      _fixed_beneficial  += _records[node].beneficial;
+      if (_mutation_log != NULL && _events[node] != 0)
+      {
+        _mutation_log->add_fixation(_events[node]);
+      }
     }
   }
+  _mrca = node;
+}
+
+/**
+ * \brief    Reset the fixed mutations counters
+ * \details  --
+ * \param    void
+ * \return   \e void
+ */
+void Tree::reset_fixations( void )
+{
+  _fixed            = 0;
+  _fixed_beneficial = 0;
+}
+
+/**
+ * \brief    Write best lineage statistics
+ * \details  The ancestors of the best individual are written in
+ *           best_lineage.txt. Their clades are written in
+ *           best_lineage_clades.txt: number of nodes, number of living
+ *           descendants and their mean fitness W(z)
+ * \param    void
+ * \return   \e void
+ */
+void Tree::write_best_lineage_statistics( void )
+{
+  unsigned int  best = get_best_alive_node();
+  unsigned int  node = best;
+  std::ofstream file("best_lineage.txt", std::ios::out | std::ios::trunc);
+  std::ofstream clade_file("best_lineage_clades.txt", std::ios::out | std::ios::trunc);
+  write_lineage_header(file);
+  clade_file << "id t clade_size clade_population clade_Wz\n";
+  while (node != NO_NODE && _nodes[node].type != MASTER_ROOT)
+  {
+    assert(is_descendant(best, node));
+    write_lineage_record(file, _records[node]);
+    clade_file << _records[node].identifier << " ";
+    clade_file << _records[node].generation << " ";
+    clade_file << get_clade_size(node) << " ";
+    clade_file << get_clade_population_size(node) << " ";
+    clade_file << get_clade_mean_fitness(node) << "\n";
+    node = _nodes[node].parent;
+  }
+  file.close();
+  clade_file.close();
+}
+
+/**
+ * \brief    Stream the ancestors shared by the whole population
+ * \details  Every living individual descends from the most recent common
+ *           ancestor (MRCA), so the MRCA and its ancestors can no longer be
+ *           pruned: they are written in the genealogy tables, and the
+ *           ancestors of the MRCA are removed from the tree. The MRCA stays as
+ *           a root (or its parent, if the MRCA is alive). Nothing is done
+ *           while the living lineages have not coalesced
+ * \param    GenealogyWriter* writer
+ * \return   \e void
+ */
+void Tree::simplify( GenealogyWriter* writer )
+{
+  /*-----------------------------*/
+  /* 1) Find the cut point       */
+  /*-----------------------------*/
+  update_mrca();
+  unsigned int cut = get_mrca();
+  if (cut == NO_NODE)
+  {
+    return;
+  }
+  if (_nodes[cut].state == ALIVE)
+  {
+    cut = _nodes[cut].parent;
+  }
+  if (cut == 0)
+  {
+    return;
+  }
   
-  /*-------------------------------------*/
-  /* 3) Delete untagged nodes            */
-  /*-------------------------------------*/
-  for (size_t i = 0; i < remove_list.size(); i++)
+  /*-----------------------------*/
+  /* 2) Write the shared lineage */
+  /*-----------------------------*/
+  unsigned int node = cut;
+  while (node != 0 && !_nodes[node].exported)
   {
-    delete_node(remove_list[i]);
+    export_node(node, writer);
+    node = _nodes[node].parent;
   }
-  remove_list.clear();
   
-  /*-------------------------------------*/
-  /* 4) Set master root children as root */
-  /*-------------------------------------*/
-  Node* master_root = _node_map[0];
-  for (int i = 0; i < master_root->get_number_of_children(); i++)
+  /*-----------------------------*/
+  /* 3) Remove the ancestors     */
+  /*-----------------------------*/
+  node = _nodes[cut].parent;
+  if (node != 0)
+  {
+    detach_child(cut);
+    attach_child(0, cut);
+    _nodes[cut].type = ROOT;
+    while (node != 0)
+    {
+      unsigned int parent = _nodes[node].parent;
+      detach_child(node);
+      release_node(node);
+      node = parent;
+    }
+  }
+  writer->flush();
+}
+
+/**
+ * \brief    Write the remaining genealogy
+ * \details  Called at the end of the simulation: the nodes not exported yet
+ *           are written with their edges, living individuals being flagged as
+ *           samples. Together with the previous exports, the tables hold the
+ *           genealogy of the final population
+ * \param    GenealogyWriter* writer
+ * \return   \e void
+ */
+void Tree::write_genealogy( GenealogyWriter* writer )
+{
+  for (unsigned int node = 1; node < _nodes.size(); node++)
   {
-    master_root->get_child(i)->set_root();
+    if (_nodes[node].in_use && !_nodes[node].exported)
+    {
+      export_node(node, writer);
+    }
   }
+  writer->flush();
 }
 
 /**
- * \brief    Write best lineage statistics
+ * \brief    Record the values of an individual
+ * \details  The phenotype and the fitness of the individual must be computed.
+ *           The individual carries one mutation if one of its mutation sizes
+ *           is not zero
+ * \param    lineage_record& record
+ * \param    Individual* individual
+ * \return   \e void
+ */
+void Tree::record_individual( lineage_record& record, Individual* individual )
+{
+  record.identifier     = individual->get_identifier();
+  record.generation     = individual->get_generation();
+  record.dmu            = individual->get_dmu();
+  record.dz             = individual->get_dz();
+  record.Wmu            = individual->get_Wmu();
+  record.Wz             = individual->get_Wz();
+  record.EV             = individual->get_max_Sigma_eigenvalue();
+  record.EV_contrib     = individual->get_max_Sigma_contribution();
+  record.EV_dot_product = individual->get_max_dot_product();
+  record.r_mu           = individual->get_r_mu();
+  record.r_sigma        = individual->get_r_sigma();
+  record.r_theta        = individual->get_r_theta();
+  record.mutations      = (record.r_mu > 0.0 || record.r_sigma > 0.0 || record.r_theta > 0.0 ? 1 : 0);
+  record.beneficial     = 0;
+}
+
+/**
+ * \brief    Write the header of a lineage file
  * \details  --
- * \param    void
+ * \param    std::ofstream& file
  * \return   \e void
  */
-void Tree::write_best_lineage_statistics( void )
+void Tree::write_lineage_header( std::ofstream& file )
 {
-  Node* node = get_best_alive_node();
-  std::ofstream file("best_lineage.txt", std::ios::out | std::ios::trunc);
   file << "id" << " ";
   file << "t" << " ";
   file << "dmu" << " ";
@@ -247,23 +538,29 @@ void Tree::write_best_lineage_statistics( void )
   file << "r_mu" << " ";
   file << "r_sigma" << " ";
   file << "r_theta" << "\n";
-  while (!node->isMasterRoot())
-  {
-    file << node->get_identifier() << " ";
-    file << node->get_generation() << " ";
-    file << node->get_individual()->get_dmu() << " ";
-    file << node->get_individual()->get_dz() << " ";
-    file << node->get_individual()->get_Wmu() << " ";
-    file << node->get_individual()->get_Wz() << " ";
-    file << node->get_individual()->get_max_Sigma_eigenvalue() << " ";
-    file << node->get_individual()->get_max_Sigma_contribution() << " ";
-    file << node->get_individual()->get_max_dot_product() << " ";
-    file << node->get_individual()->get_r_mu() << " ";
-    file << node->get_individual()->get_r_sigma() << " ";
-    file << node->get_individual()->get_r_theta() << "\n";
-    node = node->get_parent();
-  }
-  file.close();
+}
+
+/**
+ * \brief    Write a record in a lineage file
+ * \details  --
+ * \param    std::ofstream& file
+ * \param    const lineage_record& record
+ * \return   \e void
+ */
+void Tree::write_lineage_record( std::ofstream& file, const lineage_record& record )
+{
+  file << record.identifier << " ";
+  file << record.generation << " ";
+  file << record.dmu << " ";
+  file << record.dz << " ";
+  file << record.Wmu << " ";
+  file << record.Wz << " ";
+  file << record.EV << " ";
+  file << record.EV_contrib << " ";
+  file << record.EV_dot_product << " ";
+  file << record.r_mu << " ";
+  file << record.r_sigma << " ";
+  file << record.r_theta << "\n";
 }
 
 /*----------------------------
@@ -271,33 +568,324 @@ void Tree::write_best_lineage_statistics( void )
  *----------------------------*/
 
 /**
- * \brief    Tag all the offspring of this node
+ * \brief    Get a new node
+ * \details  Recycles a released slot if any, else grows the arena. The node
+ *           is alive, normal and unlinked
+ * \param    void
+ * \return   \e unsigned int
+ */
+unsigned int Tree::new_node( void )
+{
+  unsigned int node = 0;
+  if (!_free_nodes.empty())
+  {
+    node = _free_nodes.back();
+    _free_nodes.pop_back();
+  }
+  else
+  {
+    assert(_nodes.size() < (size_t)NO_NODE);
+    node = (unsigned int)_nodes.size();
+    _nodes.push_back(tree_node());
+    _records.push_back(lineage_record());
+    if (_mutation_log != NULL)
+    {
+      _events.push_back(0);
+    }
+  }
+  tree_node& slot         = _nodes[node];
+  slot.parent             = NO_NODE;
+  slot.first_child        = NO_NODE;
+  slot.next_sibling       = NO_NODE;
+  slot.previous_sibling   = NO_NODE;
+  slot.number_of_children = 0;
+  slot.type               = NORMAL;
+  slot.state              = ALIVE;
+  slot.in_use             = true;
+  slot.exported           = false;
+  slot.fixed              = false;
+  memset(&_records[node], 0, sizeof(lineage_record));
+  _number_of_nodes++;
+  return node;
+}
+
+/**
+ * \brief    Add a child at the head of the children list of a node
  * \details  --
- * \param    Node* node
- * \param    std::vector<Node*>* tagged_nodes
+ * \param    unsigned int parent
+ * \param    unsigned int child
  * \return   \e void
  */
-void Tree::tag_offspring( Node* node, std::vector<Node*>* tagged_nodes )
+void Tree::attach_child( unsigned int parent, unsigned int child )
 {
-  untag_tree();
-  tagged_nodes->clear();
-  tagged_nodes->push_back(node);
-  bool end = false;
-  while (!end)
+  assert(_nodes[child].parent == NO_NODE);
+  unsigned int first             = _nodes[parent].first_child;
+  _nodes[child].parent           = parent;
+  _nodes[child].previous_sibling = NO_NODE;
+  _nodes[child].next_sibling     = first;
+  if (first != NO_NODE)
   {
-    end = true;
-    for (int i = 0; i < (int)tagged_nodes->size(); i++)
+    _nodes[first].previous_sibling = child;
+  }
+  _nodes[parent].first_child = child;
+  _nodes[parent].number_of_children++;
+  _index_is_valid = false;
+}
+
+/**
+ * \brief    Remove a node from the children list of its parent
+ * \details  --
+ * \param    unsigned int child
+ * \return   \e void
+ */
+void Tree::detach_child( unsigned int child )
+{
+  unsigned int parent   = _nodes[child].parent;
+  unsigned int previous = _nodes[child].previous_sibling;
+  unsigned int next     = _nodes[child].next_sibling;
+  assert(parent != NO_NODE);
+  if (previous != NO_NODE)
+  {
+    _nodes[previous].next_sibling = next;
+  }
+  else
+  {
+    _nodes[parent].first_child = next;
+  }
+  if (next != NO_NODE)
+  {
+    _nodes[next].previous_sibling = previous;
+  }
+  _nodes[child].parent           = NO_NODE;
+  _nodes[child].previous_sibling = NO_NODE;
+  _nodes[child].next_sibling     = NO_NODE;
+  assert(_nodes[parent].number_of_children > 0);
+  _nodes[parent].number_of_children--;
+  _index_is_valid = false;
+}
+
+/**
+ * \brief    Release the slot of a node
+ * \details  The node must be unlinked. If it was the last MRCA found, the
+ *           next search starts from the master root. An unfixed mutation
+ *           event of the node is lost
+ * \param    unsigned int node
+ * \return   \e void
+ */
+void Tree::release_node( unsigned int node )
+{
+  assert(_nodes[node].in_use);
+  assert(_nodes[node].parent == NO_NODE);
+  assert(_nodes[node].number_of_children == 0);
+  _nodes[node].in_use = false;
+  _free_nodes.push_back(node);
+  if (_mutation_log != NULL && _events[node] != 0)
+  {
+    if (!_nodes[node].fixed)
     {
-      for (int j = 0; j < tagged_nodes->at(i)->get_number_of_children(); j++)
+      _mutation_log->add_loss(_events[node]);
+    }
+    _events[node] = 0;
+  }
+  if (node == _mrca)
+  {
+    _mrca = 0;
+  }
+  _number_of_nodes--;
+}
+
+/**
+ * \brief    Release a dead node and its dead ancestors left without children
+ * \details  Walks up from a dead node while nodes are dead and childless.
+ *           With unary collapse, the first dead node left with a single
+ *           child is also removed, unless it was exported (its children still
+ *           refer to it in the genealogy tables). The master root is never
+ *           released
+ * \param    unsigned int node
+ * \return   \e void
+ */
+void Tree::release_dead_ancestors( unsigned int node )
+{
+  while (node != 0 && _nodes[node].state == DEAD)
+  {
+    if (_nodes[node].number_of_children == 0)
+    {
+      unsigned int parent = _nodes[node].parent;
+      detach_child(node);
+      release_node(node);
+      node = parent;
+    }
+    else
+    {
+      if (_collapse_unary && _nodes[node].number_of_children == 1 && !_nodes[node].exported)
       {
-        if (!tagged_nodes->at(i)->get_child(j)->isTagged())
-        {
-          end = false;
-          tagged_nodes->at(i)->get_child(j)->tag();
-          tagged_nodes->push_back(tagged_nodes->at(i)->get_child(j));
-        }
+        delete_node(node);
       }
+      return;
     }
   }
 }
 
+/**
+ * \brief    Write a node and the edge to its parent in the genealogy tables
+ * \details  There is no edge to the master root
+ * \param    unsigned int node
+ * \param    GenealogyWriter* writer
+ * \return   \e void
+ */
+void Tree::export_node( unsigned int node, GenealogyWriter* writer )
+{
+  assert(_nodes[node].in_use);
+  assert(!_nodes[node].exported);
+  writer->write_node(_records[node], (_nodes[node].state == ALIVE ? GENEALOGY_SAMPLE : 0));
+  unsigned int parent = _nodes[node].parent;
+  if (parent != 0)
+  {
+    writer->write_edge(_records[parent].identifier, _records[node].identifier);
+  }
+  _nodes[node].exported = true;
+}
+
+/**
+ * \brief    Build the subtree index
+ * \details  Does nothing if the tree did not change since the last build.
+ *           Nodes are ranked in depth-first preorder from the master root, so
+ *           that each clade is the range of ranks between its root's rank and
+ *           its last rank. Prefix sums over ranks give the number and the
+ *           fitness of the living individuals of any clade. The cost is linear
+ *           in the number of nodes
+ * \param    void
+ * \return   \e void
+ */
+void Tree::build_index( void )
+{
+  if (_index_is_valid)
+  {
+    return;
+  }
+  
+  /*-----------------------------*/
+  /* 1) Rank nodes in preorder   */
+  /*-----------------------------*/
+  _first_rank.resize(_nodes.size());
+  _last_rank.resize(_nodes.size());
+  _preorder.clear();
+  _stack.clear();
+  _stack.push_back(0);
+  while (!_stack.empty())
+  {
+    unsigned int node = _stack.back();
+    _stack.pop_back();
+    _first_rank[node] = (unsigned int)_preorder.size();
+    _last_rank[node]  = _first_rank[node];
+    _preorder.push_back(node);
+    for (unsigned int child = _nodes[node].first_child; child != NO_NODE; child = _nodes[child].next_sibling)
+    {
+      _stack.push_back(child);
+    }
+  }
+  assert(_preorder.size() == (size_t)_number_of_nodes);
+  
+  /*-----------------------------*/
+  /* 2) Find the last ranks      */
+  /*-----------------------------*/
+  for (size_t rank = _preorder.size()-1; rank > 0; rank--)
+  {
+    unsigned int node   = _preorder[rank];
+    unsigned int parent = _nodes[node].parent;
+    if (_last_rank[parent] < _last_rank[node])
+    {
+      _last_rank[parent] = _last_rank[node];
+    }
+  }
+  
+  /*-----------------------------*/
+  /* 3) Compute the prefix sums  */
+  /*-----------------------------*/
+  _alive_prefix.resize(_preorder.size()+1);
+  _Wz_prefix.resize(_preorder.size()+1);
+  _alive_prefix[0] = 0;
+  _Wz_prefix[0]    = 0.0;
+  for (size_t rank = 0; rank < _preorder.size(); rank++)
+  {
+    bool alive            = (_nodes[_preorder[rank]].state == ALIVE);
+    _alive_prefix[rank+1] = _alive_prefix[rank]+(alive ? 1 : 0);
+    _Wz_prefix[rank+1]    = _Wz_prefix[rank]+(alive ? _records[_preorder[rank]].Wz : 0.0);
+  }
+  _index_is_valid = true;
+#ifdef DEBUG
+  check_index();
+#endif
+}
+
+/**
+ * \brief    Check the subtree index against a breadth-first traversal
+ * \details  Debug only. Clade sizes, living individuals and descendants are
+ *           recomputed bottom-up from a breadth-first traversal, which does
+ *           not rely on ranks, and compared with the index queries. The cost
+ *           is linear in the number of nodes
+ * \param    void
+ * \return   \e void
+ */
+void Tree::check_index( void )
+{
+  /*-----------------------------*/
+  /* 1) Traverse breadth-first   */
+  /*-----------------------------*/
+  std::vector<unsigned int> order(1, 0);
+  for (size_t i = 0; i < order.size(); i++)
+  {
+    for (unsigned int child = _nodes[order[i]].first_child; child != NO_NODE; child = _nodes[child].next_sibling)
+    {
+      order.push_back(child);
+    }
+  }
+  assert(order.size() == _preorder.size());
+  
+  /*-----------------------------*/
+  /* 2) Sum the clades bottom-up */
+  /*-----------------------------*/
+  std::vector<unsigned int> size(_nodes.size(), 0);
+  std::vector<unsigned int> alive(_nodes.size(), 0);
+  std::vector<double>       Wz_sum(_nodes.size(), 0.0);
+  for (size_t i = order.size(); i-- > 0;)
+  {
+    unsigned int node = order[i];
+    size[node]       += 1;
+    if (_nodes[node].state == ALIVE)
+    {
+      alive[node]  += 1;
+      Wz_sum[node] += _records[node].Wz;
+    }
+    if (node != 0)
+    {
+      unsigned int parent = _nodes[node].parent;
+      size[parent]       += size[node];
+      alive[parent]      += alive[node];
+      Wz_sum[parent]     += Wz_sum[node];
+    }
+  }
+  
+  /*-----------------------------*/
+  /* 3) Compare with the index   */
+  /*-----------------------------*/
+  std::vector<unsigned int> descendants;
+  for (size_t i = 0; i < order.size(); i++)
+  {
+    unsigned int node = order[i];
+    assert(get_clade_size(node) == size[node]);
+    assert(get_clade_population_size(node) == alive[node]);
+    assert(alive[node] == 0 || fabs(get_clade_mean_fitness(node)-Wz_sum[node]/(double)alive[node]) <= 1e-9*(1.0+Wz_sum[node]/(double)alive[node]));
+    assert(node == 0 || is_descendant(node, _nodes[node].parent));
+    assert(node == 0 || !is_descendant(_nodes[node].parent, node));
+    if (size[node] <= CLADE_DIRECT_SUM)
+    {
+      get_descendants(node, &descendants);
+      assert(descendants.size() == size[node]);
+      for (size_t j = 0; j < descendants.size(); j++)
+      {
+        assert(is_descendant(descendants[j], node));
+      }
+    }
+  }
+}
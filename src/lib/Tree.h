@@ -32,16 +32,18 @@
 
 #include <iostream>
 #include <vector>
-#include <unordered_map>
 #include <cstring>
 #include <cmath>
 #include <fstream>
 #include <sstream>
+#include <assert.h>
 
 #include "Macros.h"
 #include "Enums.h"
+#include "Structs.h"
 #include "Individual.h"
-#include "Node.h"
+#include "GenealogyWriter.h"
+#include "MutationLog.h"
 
 
 class Tree
@@ -52,7 +54,8 @@ public:
   /*----------------------------
    * CONSTRUCTORS
    *----------------------------*/
-  Tree( void );
+  Tree( void ) = delete;
+  Tree( bool collapse_unary );
   Tree( const Tree& tree ) = delete;
   
   /*----------------------------
@@ -63,25 +66,42 @@ public:
   /*----------------------------
    * GETTERS
    *----------------------------*/
-  inline int    get_number_of_nodes( void ) const;
-  inline Node*  get_node( unsigned long long int identifier );
-  inline Node*  get_first_node( void );
-  inline Node*  get_next_node( void );
-  inline Node*  get_best_alive_node( void );
+  inline int                    get_number_of_nodes( void ) const;
+  inline unsigned int           get_arena_size( void ) const;
+  inline const tree_node*       get_node( unsigned int node ) const;
+  inline const lineage_record*  get_record( unsigned int node ) const;
+  inline unsigned int           get_best_alive_node( void ) const;
+  inline unsigned int           get_mrca( void ) const;
+  inline unsigned long long int get_number_of_fixed_mutations( void ) const;
+  inline unsigned long long int get_number_of_fixed_beneficial_mutations( void ) const;
   
   /*----------------------------
    * SETTERS
    *----------------------------*/
   Tree& operator=(const Tree&) = delete;
   
+  void set_mutation_log( MutationLog* mutation_log );
+  
   /*----------------------------
    * PUBLIC METHODS
    *----------------------------*/
-  void add_root( Individual* individual );
-  void add_reproduction_event( Individual* parent, Individual* child );
-  void delete_node( unsigned long long int node_identifier );
-  void prune();
-  void write_best_lineage_statistics( void );
+  void         add_root( Individual* individual );
+  void         add_reproduction_event( Individual* parent, Individual* child );
+  void         add_death_event( Individual* individual );
+  void         delete_node( unsigned int node );
+  void         get_descendants( unsigned int node, std::vector<unsigned int>* descendants );
+  bool         is_descendant( unsigned int node, unsigned int ancestor );
+  unsigned int get_clade_size( unsigned int node );
+  unsigned int get_clade_population_size( unsigned int node );
+  double       get_clade_mean_fitness( unsigned int node );
+  void         update_mrca( void );
+  void         reset_fixations( void );
+  void         write_best_lineage_statistics( void );
+  void         simplify( GenealogyWriter* writer );
+  void         write_genealogy( GenealogyWriter* writer );
+  static void  record_individual( lineage_record& record, Individual* individual );
+  static void  write_lineage_header( std::ofstream& file );
+  static void  write_lineage_record( std::ofstream& file, const lineage_record& record );
   
   /*----------------------------
    * PUBLIC ATTRIBUTES
@@ -92,15 +112,41 @@ protected:
   /*----------------------------
    * PROTECTED METHODS
    *----------------------------*/
-  inline void tag_tree();
-  inline void untag_tree();
-  void        tag_offspring( Node* node, std::vector<Node*>* tagged_nodes );
+  unsigned int new_node( void );
+  void         attach_child( unsigned int parent, unsigned int child );
+  void         detach_child( unsigned int child );
+  void         release_node( unsigned int node );
+  void         release_dead_ancestors( unsigned int node );
+  void         export_node( unsigned int node, GenealogyWriter* writer );
+  void         build_index( void );
+  void         check_index( void );
   
   /*----------------------------
    * PROTECTED ATTRIBUTES
    *----------------------------*/
-  std::unordered_map<unsigned long long int, Node*>           _node_map; /*!< Tree nodes map    */
-  std::unordered_map<unsigned long long int, Node*>::iterator _iterator; /*!< Tree map iterator */
+  std::vector<tree_node>      _nodes;            /*!< Node arena (slot 0 is the master root) */
+  std::vector<lineage_record> _records;          /*!< Values of each node (same slots)       */
+  std::vector<unsigned int>   _free_nodes;       /*!< Released slots, recycled first         */
+  int                         _number_of_nodes;  /*!< Number of slots in use                 */
+  bool                        _collapse_unary;   /*!< Dead nodes with one child are removed  */
+  unsigned int                _mrca;             /*!< Last MRCA found (0 if not coalesced)   */
+  unsigned long long int      _fixed;            /*!< Number of fixed mutations              */
+  unsigned long long int      _fixed_beneficial; /*!< Number of fixed beneficial mutations   */
+  
+  /*----------------------------------------------- MUTATION LOG */
+  
+  MutationLog*                        _mutation_log; /*!< Mutation events (NULL if not logged)     */
+  std::vector<unsigned long long int> _events;       /*!< Mutation event of each node (0 if none) */
+  
+  /*----------------------------------------------- SUBTREE INDEX */
+  
+  bool                        _index_is_valid;   /*!< The index matches the tree             */
+  std::vector<unsigned int>   _preorder;         /*!< Nodes in depth-first preorder          */
+  std::vector<unsigned int>   _first_rank;       /*!< Preorder rank of each node (by slot)   */
+  std::vector<unsigned int>   _last_rank;        /*!< Last rank of the subtree (by slot)     */
+  std::vector<unsigned int>   _alive_prefix;     /*!< Living nodes before each rank          */
+  std::vector<double>         _Wz_prefix;        /*!< W(z) of living nodes before each rank  */
+  std::vector<unsigned int>   _stack;            /*!< Depth-first search stack               */
 };
 
 
@@ -116,115 +162,107 @@ protected:
  */
 inline int Tree::get_number_of_nodes( void ) const
 {
-  return (int)_node_map.size();
+  return _number_of_nodes;
 }
 
 /**
- * \brief    Get the node by its identifier
- * \details  Return NULL if the node do not exist
- * \param    unsigned long long int identifier
- * \return   \e Node*
+ * \brief    Get the size of the node arena
+ * \details  Slots from 0 to the arena size, in use or free
+ * \param    void
+ * \return   \e unsigned int
  */
-inline Node* Tree::get_node( unsigned long long int identifier )
+inline unsigned int Tree::get_arena_size( void ) const
 {
-  if (_node_map.find(identifier) != _node_map.end())
-  {
-    return _node_map[identifier];
-  }
-  return NULL;
+  return (unsigned int)_nodes.size();
 }
 
 /**
- * \brief    Get the first node of the map
- * \details  Return NULL if the tree is empty
- * \param    void
- * \return   \e Node*
+ * \brief    Get a node by its index
+ * \details  The pointer is invalidated when nodes are added
+ * \param    unsigned int node
+ * \return   \e const tree_node*
  */
-inline Node* Tree::get_first_node( void )
+inline const tree_node* Tree::get_node( unsigned int node ) const
 {
-  _iterator = _node_map.begin();
-  if (_iterator != _node_map.end())
-  {
-    return _iterator->second;
-  }
-  return NULL;
+  assert(node < _nodes.size());
+  return &_nodes[node];
 }
 
 /**
- * \brief    Get the next node
- * \details  Return NULL if the end of the tree is reached
- * \param    void
- * \return   \e Node*
+ * \brief    Get the values recorded in a node
+ * \details  The pointer is invalidated when nodes are added
+ * \param    unsigned int node
+ * \return   \e const lineage_record*
  */
-inline Node* Tree::get_next_node( void )
+inline const lineage_record* Tree::get_record( unsigned int node ) const
 {
-  _iterator++;
-  if (_iterator != _node_map.end())
-  {
-    return _iterator->second;
-  }
-  return NULL;
+  assert(node < _records.size());
+  return &_records[node];
 }
 
 /**
  * \brief    Get best alive node
- * \details  --
+ * \details  Return NO_NODE if no node is alive
  * \param    void
- * \return   \e Node*
+ * \return   \e unsigned int
  */
-inline Node* Tree::get_best_alive_node( void )
+inline unsigned int Tree::get_best_alive_node( void ) const
 {
-  double best_w    = 0.0;
-  Node*  best_node = NULL;
-  for (_iterator = _node_map.begin(); _iterator != _node_map.end(); ++_iterator)
+  double       best_w    = 0.0;
+  unsigned int best_node = NO_NODE;
+  for (unsigned int i = 0; i < _nodes.size(); i++)
   {
-    if (_iterator->second->isAlive())
+    if (_nodes[i].in_use && _nodes[i].state == ALIVE && best_w < _records[i].Wz)
     {
-      if (best_w < _iterator->second->get_individual()->get_Wz())
-      {
-        best_w    = _iterator->second->get_individual()->get_Wz();
-        best_node = _iterator->second;
-      }
+      best_w    = _records[i].Wz;
+      best_node = i;
     }
   }
   return best_node;
 }
 
-/*----------------------------
- * SETTERS
- *----------------------------*/
-
-/*----------------------------
- * PROTECTED METHODS
- *----------------------------*/
+/**
+ * \brief    Get the most recent common ancestor of the living population
+ * \details  As found by the last call to update_mrca(). Return NO_NODE if
+ *           the living lineages have not coalesced
+ * \param    void
+ * \return   \e unsigned int
+ */
+inline unsigned int Tree::get_mrca( void ) const
+{
+  return (_mrca == 0 ? NO_NODE : _mrca);
+}
 
 /**
- * \brief    Tag all the nodes
- * \details  --
+ * \brief    Get the number of fixed mutations
+ * \details  Mutations carried by the whole living population, since the last
+ *           reset
  * \param    void
- * \return   \e void
+ * \return   \e unsigned long long int
  */
-inline void Tree::tag_tree()
+inline unsigned long long int Tree::get_number_of_fixed_mutations( void ) const
 {
-  for (_iterator = _node_map.begin(); _iterator != _node_map.end(); ++_iterator)
-  {
-    _iterator->second->tag();
-  }
+  return _fixed;
 }
 
 /**
- * \brief    Untag all the nodes
- * \details  --
+ * \brief    Get the number of fixed beneficial mutations
+ * \details  Fixed mu mutations which increased W(mu) at birth
  * \param    void
- * \return   \e void
+ * \return   \e unsigned long long int
  */
-inline void Tree::untag_tree()
+inline unsigned long long int Tree::get_number_of_fixed_beneficial_mutations( void ) const
 {
-  for (_iterator = _node_map.begin(); _iterator != _node_map.end(); ++_iterator)
-  {
-    _iterator->second->untag();
-  }
+  return _fixed_beneficial;
 }
 
+/*----------------------------
+ * SETTERS
+ *----------------------------*/
+
+/*----------------------------
+ * PROTECTED METHODS
+ *----------------------------*/
+
 
 #endif /* defined(__SigmaFGM__Tree__) */
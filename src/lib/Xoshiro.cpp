@@ -0,0 +1,124 @@
+/**
+ * \file      Xoshiro.cpp
+ * \authors   Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * \date      18-10-2026
+ * \copyright Copyright (C) 2016-2020 Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard. All rights reserved
+ * \license   This project is released under the GNU General Public License
+ * \brief     Xoshiro class definition
+ */
+
+/***********************************************************************
+ * Copyright (C) 2016-2020
+ * Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * Web: https://github.com/charlesrocabert/SigmaFGM/
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#include "Xoshiro.h"
+
+const gsl_rng_type Xoshiro::_gsl_type =
+{
+  "xoshiro256++",
+  0xFFFFFFFFUL,
+  0,
+  sizeof(xoshiro_state),
+  &Xoshiro::set,
+  &Xoshiro::get,
+  &Xoshiro::get_double
+};
+
+
+/*----------------------------
+ * GETTERS
+ *----------------------------*/
+
+/**
+ * \brief    Get the GSL generator type
+ * \details  Allows the generator to be used through gsl_rng and Prng
+ * \param    void
+ * \return   \e const gsl_rng_type*
+ */
+const gsl_rng_type* Xoshiro::get_gsl_type( void )
+{
+  return &_gsl_type;
+}
+
+/*----------------------------
+ * PUBLIC METHODS
+ *----------------------------*/
+
+/**
+ * \brief    Fill a block with uniform draws in [0,1)
+ * \details  Gives the same values as n calls to uniform()
+ * \param    xoshiro_state* state
+ * \param    double* x
+ * \param    int n
+ * \return   \e void
+ */
+void Xoshiro::fill_uniform( xoshiro_state* state, double* x, int n )
+{
+  for (int i = 0; i < n; i++)
+  {
+    x[i] = uniform(state);
+  }
+}
+
+/*----------------------------
+ * PROTECTED METHODS
+ *----------------------------*/
+
+/**
+ * \brief    Seed the generator (gsl_rng_set)
+ * \details  The four state words are drawn from splitmix64, as recommended by
+ *           the authors, so that the state is never all zeros
+ * \param    void* state
+ * \param    unsigned long int seed
+ * \return   \e void
+ */
+void Xoshiro::set( void* state, unsigned long int seed )
+{
+  xoshiro_state* s = (xoshiro_state*)state;
+  uint64_t       z = (uint64_t)seed;
+  for (int i = 0; i < 4; i++)
+  {
+    z          += 0x9E3779B97F4A7C15ULL;
+    uint64_t w  = z;
+    w           = (w^(w >> 30))*0xBF58476D1CE4E5B9ULL;
+    w           = (w^(w >> 27))*0x94D049BB133111EBULL;
+    s->s[i]     = w^(w >> 31);
+  }
+}
+
+/**
+ * \brief    Draw 32 random bits (gsl_rng_get)
+ * \details  Upper bits of the 64-bit output
+ * \param    void* state
+ * \return   \e unsigned long int
+ */
+unsigned long int Xoshiro::get( void* state )
+{
+  return (unsigned long int)(next((xoshiro_state*)state) >> 32);
+}
+
+/**
+ * \brief    Draw a uniform double in [0,1) (gsl_rng_uniform)
+ * \details  --
+ * \param    void* state
+ * \return   \e double
+ */
+double Xoshiro::get_double( void* state )
+{
+  return uniform((xoshiro_state*)state);
+}
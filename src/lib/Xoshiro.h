@@ -0,0 +1,139 @@
+/**
+ * \file      Xoshiro.h
+ * \authors   Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * \date      18-10-2026
+ * \copyright Copyright (C) 2016-2020 Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard. All rights reserved
+ * \license   This project is released under the GNU General Public License
+ * \brief     Xoshiro class declaration
+ */
+
+/***********************************************************************
+ * Copyright (C) 2016-2020
+ * Charles Rocabert, Guillaume Beslon, Carole Knibbe, Samuel Bernard
+ * Web: https://github.com/charlesrocabert/SigmaFGM/
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#ifndef __SigmaFGM__Xoshiro__
+#define __SigmaFGM__Xoshiro__
+
+#include <iostream>
+#include <cstdint>
+#include <gsl/gsl_rng.h>
+#include <assert.h>
+
+#include "Macros.h"
+#include "Enums.h"
+#include "Structs.h"
+
+
+class Xoshiro
+{
+  
+public:
+  
+  /*----------------------------
+   * CONSTRUCTORS
+   *----------------------------*/
+  Xoshiro( void ) = delete;
+  Xoshiro( const Xoshiro& xoshiro ) = delete;
+  
+  /*----------------------------
+   * DESTRUCTORS
+   *----------------------------*/
+  
+  /*----------------------------
+   * GETTERS
+   *----------------------------*/
+  static const gsl_rng_type* get_gsl_type( void );
+  
+  /*----------------------------
+   * SETTERS
+   *----------------------------*/
+  Xoshiro& operator=(const Xoshiro&) = delete;
+  
+  /*----------------------------
+   * PUBLIC METHODS
+   *----------------------------*/
+  static inline uint64_t next( xoshiro_state* state );
+  static inline double   uniform( xoshiro_state* state );
+  static void            fill_uniform( xoshiro_state* state, double* x, int n );
+  
+  /*----------------------------
+   * PUBLIC ATTRIBUTES
+   *----------------------------*/
+  
+protected:
+  
+  /*----------------------------
+   * PROTECTED METHODS
+   *----------------------------*/
+  static void              set( void* state, unsigned long int seed );
+  static unsigned long int get( void* state );
+  static double            get_double( void* state );
+  
+  /*----------------------------
+   * PROTECTED ATTRIBUTES
+   *----------------------------*/
+  static const gsl_rng_type _gsl_type; /*!< GSL description of the generator */
+};
+
+
+/*----------------------------
+ * GETTERS
+ *----------------------------*/
+
+/*----------------------------
+ * SETTERS
+ *----------------------------*/
+
+/*----------------------------
+ * PUBLIC METHODS
+ *----------------------------*/
+
+/**
+ * \brief    Draw 64 random bits
+ * \details  xoshiro256++ (Blackman and Vigna 2019)
+ * \param    xoshiro_state* state
+ * \return   \e uint64_t
+ */
+inline uint64_t Xoshiro::next( xoshiro_state* state )
+{
+  uint64_t* s      = state->s;
+  uint64_t  sum    = s[0]+s[3];
+  uint64_t  result = ((sum << 23) | (sum >> 41))+s[0];
+  uint64_t  t      = s[1] << 17;
+  s[2]            ^= s[0];
+  s[3]            ^= s[1];
+  s[1]            ^= s[2];
+  s[0]            ^= s[3];
+  s[2]            ^= t;
+  s[3]             = (s[3] << 45) | (s[3] >> 19);
+  return result;
+}
+
+/**
+ * \brief    Draw a uniform double in [0,1)
+ * \details  53 random bits
+ * \param    xoshiro_state* state
+ * \return   \e double
+ */
+inline double Xoshiro::uniform( xoshiro_state* state )
+{
+  return (double)(next(state) >> 11)/9007199254740992.0;
+}
+
+
+#endif /* defined(__SigmaFGM__Xoshiro__) */